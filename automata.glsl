@@ -0,0 +1,173 @@
+#ifndef AUTOMATA_GLSL
+#define AUTOMATA_GLSL
+
+#include "config.hpp"
+
+layout(set = 2, binding = 0) uniform uniformRules
+{
+    uint seed;
+    uint surviveMask;
+    uint birthMask;
+    uint life;
+    uint neighborhood;
+    uint frame;
+    uint width;
+    uint height;
+    uint depth;
+    uint boundary;
+    uint radius;
+    uint birthMin;
+    uint birthMax;
+    uint surviveMin;
+    uint surviveMax;
+    float frequency;
+    float threshold;
+};
+
+/* specialized variants (see add_shader_variants) bake these into the shader */
+#ifdef NEIGHBORHOOD
+#define neighborhood NEIGHBORHOOD
+#endif
+#ifdef BOUNDARY
+#define boundary BOUNDARY
+#endif
+
+#ifdef BATCH
+layout(set = 2, binding = 1) uniform uniformBatch
+{
+    uint universesX;
+    uint universesY;
+    uint universesZ;
+    uint count;
+};
+#endif
+
+const ivec3 Moore[26] = ivec3[](
+    ivec3(-1,-1,-1), ivec3( 0,-1,-1), ivec3( 1,-1,-1),
+    ivec3(-1, 0,-1), ivec3( 0, 0,-1), ivec3( 1, 0,-1),
+    ivec3(-1, 1,-1), ivec3( 0, 1,-1), ivec3( 1, 1,-1),
+    ivec3(-1,-1, 0), ivec3( 0,-1, 0), ivec3( 1,-1, 0),
+    ivec3(-1, 0, 0),                  ivec3( 1, 0, 0),
+    ivec3(-1, 1, 0), ivec3( 0, 1, 0), ivec3( 1, 1, 0),
+    ivec3(-1,-1, 1), ivec3( 0,-1, 1), ivec3( 1,-1, 1),
+    ivec3(-1, 0, 1), ivec3( 0, 0, 1), ivec3( 1, 0, 1),
+    ivec3(-1, 1, 1), ivec3( 0, 1, 1), ivec3( 1, 1, 1)
+);
+
+const ivec3 VonNeumann[6] = ivec3[](
+    ivec3(-1, 0, 0),
+    ivec3( 1, 0, 0),
+    ivec3( 0,-1, 0),
+    ivec3( 0, 1, 0),
+    ivec3( 0, 0,-1),
+    ivec3( 0, 0, 1)
+);
+
+ivec3 GetBounds()
+{
+    return ivec3(width, height, depth);
+}
+
+/* alive bit-plane words along x */
+ivec3 GetWordBounds()
+{
+    return ivec3((width + 31) / 32, height, depth);
+}
+
+/* nibble-packed words (8 cells each) along x */
+ivec3 GetNibbleBounds()
+{
+    return ivec3((width + 7) / 8, height, depth);
+}
+
+/* active bricks (one workgroup each) along each axis */
+ivec3 GetBricks()
+{
+    return (GetBounds() + THREADS - 1) / THREADS;
+}
+
+ivec3 GetBrickId(uint brick)
+{
+    ivec3 bricks = GetBricks();
+    ivec3 brickId;
+    brickId.x = int(brick) % bricks.x;
+    brickId.y = int(brick) / bricks.x % bricks.y;
+    brickId.z = int(brick) / (bricks.x * bricks.y);
+    return brickId;
+}
+
+uint GetBrickCount()
+{
+    ivec3 bricks = GetBricks();
+    return uint(bricks.x * bricks.y * bricks.z);
+}
+
+#ifdef BATCH
+/* universes are tiled along each axis and the bounds are the size of one of them,
+ * returns count for invocations past the last universe */
+uint GetUniverse(ivec3 globalId, out ivec3 id, out ivec3 origin)
+{
+    ivec3 bounds = GetBounds();
+    ivec3 universeId = globalId / bounds;
+    id = globalId % bounds;
+    origin = universeId * bounds;
+    if (any(greaterThanEqual(universeId, ivec3(universesX, universesY, universesZ))))
+    {
+        return count;
+    }
+    return min(count, universeId.x + universesX * (universeId.y + universesY * universeId.z));
+}
+#endif
+
+bool OutOfBounds(ivec3 id)
+{
+    return any(lessThan(id, ivec3(0))) || any(greaterThanEqual(id, GetBounds()));
+}
+
+/* wraps the id on a torus, otherwise returns false if it's past the dead boundary */
+bool ApplyBoundary(inout ivec3 id)
+{
+    if (boundary == BOUNDARY_TORUS)
+    {
+        ivec3 bounds = GetBounds();
+        id = (id % bounds + bounds) % bounds;
+        return true;
+    }
+    return !OutOfBounds(id);
+}
+
+/* kernels that look transitions up define the binding, since it follows their own readonly resources */
+#ifdef TRANSITION_BINDING
+layout(set = 0, binding = TRANSITION_BINDING) readonly buffer bufferTransitions
+{
+    uint transitions[];
+};
+
+int Transition(int value, uint neighbors)
+{
+    return int(transitions[value * COUNTS + neighbors]);
+}
+#endif
+
+int Transition(int value, bool birth, bool survive)
+{
+    if (value == 0 && birth)
+    {
+        value = int(life);
+    }
+    else if (!survive)
+    {
+        value--;
+    }
+    return max(0, value);
+}
+
+/* larger than life rules count too many neighbors for a mask and use ranges instead */
+int TransitionRange(int value, uint neighbors)
+{
+    bool birth = neighbors >= birthMin && neighbors <= birthMax;
+    bool survive = neighbors >= surviveMin && neighbors <= surviveMax;
+    return Transition(value, birth, survive);
+}
+
+#endif
\ No newline at end of file
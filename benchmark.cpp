@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "bitengine.hpp"
+#include "rules.hpp"
+#include "scheduler.hpp"
+
+/* how many cells each measurement steps through at least */
+static constexpr double CELLS = 4e9;
+
+/* strong scaling of the bit-sliced engine with the default rules, benchmark [--pin] [size...] */
+int main(int argc, char** argv)
+{
+    bool pin = false;
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!std::strcmp(argv[i], "--pin"))
+        {
+            pin = true;
+        }
+        else
+        {
+            sizes.push_back(std::max(1, std::atoi(argv[i])));
+        }
+    }
+    if (sizes.empty())
+    {
+        sizes = {256, 1024};
+    }
+    int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+    for (int size : sizes)
+    {
+        Rules rules;
+        rules.width = size;
+        rules.height = size;
+        rules.depth = size;
+        BitEngine engine;
+        engine.SetRules(rules);
+        {
+            Scheduler scheduler(0, pin);
+            engine.SetScheduler(&scheduler);
+            engine.Step();
+            engine.SetScheduler(nullptr);
+        }
+        double cells = double(size) * size * size;
+        int steps = std::max(2, int(CELLS / cells));
+        std::printf("%d^3, %d steps\n", size, steps);
+        std::printf("%8s %12s %12s %8s %10s\n", "threads", "ms/step", "Gcells/s", "speedup", "efficiency");
+        double baseline = 0.0;
+        for (int threads : threadCounts)
+        {
+            Scheduler scheduler(threads, pin);
+            engine.SetScheduler(&scheduler);
+            /* one step to fault the pages in and wake the threads */
+            engine.Step();
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < steps; i++)
+            {
+                engine.Step();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / steps;
+            engine.SetScheduler(nullptr);
+            baseline = baseline > 0.0 ? baseline : seconds;
+            double speedup = baseline / seconds;
+            std::printf("%8d %12.3f %12.3f %8.2f %9.0f%%\n", threads, seconds * 1e3,
+                cells / seconds / 1e9, speedup, speedup / threads * 100.0);
+        }
+    }
+    return 0;
+}
\ No newline at end of file
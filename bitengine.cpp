@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include "bitengine.hpp"
+#include "engine.hpp"
+#include "scheduler.hpp"
+
+/* counts up to 26 neighbors need 5 bit planes */
+static constexpr int PLANES = 5;
+/* and states up to MAX_LIFE need this many */
+static constexpr int STATE_PLANES = std::bit_width(unsigned(MAX_LIFE));
+/* the widest vector, which the spare rows are sized for whichever one runs */
+static constexpr int MAX_LANES = 8;
+
+/* what the step of one plane reads and writes */
+struct Kernel
+{
+    const uint64_t* bits;
+    uint64_t* nextBits;
+    int words;
+    int rows;
+    int width;
+    int height;
+    int planes;
+    size_t planeSize;
+    bool moore;
+    uint32_t birthMask;
+    uint32_t surviveMask;
+    uint32_t life;
+
+    size_t GetIndex(int w, int y, int z) const
+    {
+        return (size_t(z) * (words + 2) + w) * rows + y;
+    }
+};
+
+/* the kernel is built for each instruction set and picked at runtime, so the same binary runs on any
+ * x86 cpu without being built for the host */
+namespace Scalar
+{
+#define BIT_LANES 1
+#include "bitlanes.hpp"
+#undef BIT_LANES
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+namespace Avx2
+{
+#define BIT_LANES 4
+#include "bitlanes.hpp"
+#undef BIT_LANES
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+namespace Avx512
+{
+#define BIT_LANES 8
+#include "bitlanes.hpp"
+#undef BIT_LANES
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
+
+using StepFunction = void (*)(const Kernel& kernel, int z);
+
+static StepFunction GetStepFunction()
+{
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return Avx512::StepPlane;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return Avx2::StepPlane;
+    }
+#elif defined(_MSC_VER) && defined(_M_X64)
+    /* the cpu has to support the instructions and the os has to save the registers */
+    int info[4];
+    __cpuid(info, 1);
+    bool xsave = (info[2] >> 27) & 1;
+    uint64_t registers = xsave ? _xgetbv(0) : 0;
+    __cpuidex(info, 7, 0);
+    if ((info[1] >> 16) & 1 && (registers & 0xE6) == 0xE6)
+    {
+        return Avx512::StepPlane;
+    }
+    if ((info[1] >> 5) & 1 && (registers & 0x6) == 0x6)
+    {
+        return Avx2::StepPlane;
+    }
+#endif
+    return Scalar::StepPlane;
+}
+
+static const StepFunction stepPlane = GetStepFunction();
+
+bool BitEngine::SetRules(const Rules& newRules)
+{
+    if (newRules.life < 1 || newRules.life > MAX_LIFE || newRules.neighborhood > VON_NEUMANN)
+    {
+        return false;
+    }
+    int newPlanes = std::bit_width(newRules.life);
+    bool resized = newRules.width != rules.width || newRules.height != rules.height ||
+        newRules.depth != rules.depth || newPlanes != planes || bits.empty();
+    rules = newRules;
+    if (resized)
+    {
+        planes = newPlanes;
+        words = (rules.width + 63) / 64;
+        rows = rules.height + 2 + MAX_LANES;
+        planeSize = size_t(words + 2) * rows * (rules.depth + 2);
+        bits.assign(planeSize * (planes + 1), 0);
+        nextBits.assign(planeSize * (planes + 1), 0);
+    }
+    return true;
+}
+
+const Rules& BitEngine::GetRules() const
+{
+    return rules;
+}
+
+void BitEngine::SetScheduler(Scheduler* newScheduler)
+{
+    scheduler = newScheduler;
+}
+
+size_t BitEngine::GetIndex(int w, int y, int z) const
+{
+    return (size_t(z) * (words + 2) + w) * rows + y;
+}
+
+void BitEngine::SetCells(const std::vector<uint8_t>& newCells)
+{
+    if (newCells.size() != size_t(rules.width) * rules.height * rules.depth)
+    {
+        return;
+    }
+    std::fill(bits.begin(), bits.end(), 0);
+    size_t i = 0;
+    for (int z = 0; z < int(rules.depth); z++)
+    {
+        for (int y = 0; y < int(rules.height); y++)
+        {
+            for (int x = 0; x < int(rules.width); x++)
+            {
+                uint32_t value = newCells[i++];
+                size_t index = GetIndex(x / 64 + 1, y + 1, z + 1);
+                bits[index] |= uint64_t(value > 0) << (x % 64);
+                for (int plane = 0; plane < planes; plane++)
+                {
+                    bits[index + (plane + 1) * planeSize] |= uint64_t((value >> plane) & 1) << (x % 64);
+                }
+            }
+        }
+    }
+}
+
+const std::vector<uint8_t>& BitEngine::GetCells()
+{
+    cells.resize(size_t(rules.width) * rules.height * rules.depth);
+    size_t i = 0;
+    for (int z = 0; z < int(rules.depth); z++)
+    {
+        for (int y = 0; y < int(rules.height); y++)
+        {
+            for (int x = 0; x < int(rules.width); x++)
+            {
+                size_t index = GetIndex(x / 64 + 1, y + 1, z + 1);
+                uint8_t value = 0;
+                for (int plane = 0; plane < planes; plane++)
+                {
+                    value |= ((bits[index + (plane + 1) * planeSize] >> (x % 64)) & 1) << plane;
+                }
+                cells[i++] = value;
+            }
+        }
+    }
+    return cells;
+}
+
+/* fills the ghost words, rows and planes of the alive bits from the other side on a torus and with
+ * dead cells otherwise, the states are only read at the center and need none */
+void BitEngine::Refresh()
+{
+    bool torus = rules.boundary == BOUNDARY_TORUS;
+    int width = rules.width;
+    int height = rules.height;
+    int depth = rules.depth;
+    int last = (width - 1) / 64 + 1;
+    for (int z = 1; z <= depth; z++)
+    {
+        for (int y = 1; y <= height; y++)
+        {
+            uint64_t first = bits[GetIndex(1, y, z)] & 1;
+            uint64_t end = (bits[GetIndex(last, y, z)] >> ((width - 1) % 64)) & 1;
+            bits[GetIndex(0, y, z)] = torus ? end << 63 : 0;
+            bits[GetIndex(words + 1, y, z)] = 0;
+            /* the cell past the last one, which the east shift reads */
+            if (torus && width % 64)
+            {
+                bits[GetIndex(last, y, z)] |= first << (width % 64);
+            }
+            else if (torus)
+            {
+                bits[GetIndex(words + 1, y, z)] = first;
+            }
+        }
+        for (int w = 0; w < words + 2; w++)
+        {
+            bits[GetIndex(w, 0, z)] = torus ? bits[GetIndex(w, height, z)] : 0;
+            bits[GetIndex(w, height + 1, z)] = torus ? bits[GetIndex(w, 1, z)] : 0;
+        }
+    }
+    size_t plane = size_t(words + 2) * rows;
+    uint64_t* front = &bits[GetIndex(0, 0, 0)];
+    uint64_t* back = &bits[GetIndex(0, 0, depth + 1)];
+    if (torus)
+    {
+        std::memcpy(front, &bits[GetIndex(0, 0, depth)], plane * sizeof(uint64_t));
+        std::memcpy(back, &bits[GetIndex(0, 0, 1)], plane * sizeof(uint64_t));
+    }
+    else
+    {
+        std::memset(front, 0, plane * sizeof(uint64_t));
+        std::memset(back, 0, plane * sizeof(uint64_t));
+    }
+}
+
+/* seeded cells have a state of 1, so only the alive bits and the lowest state bits are set */
+void BitEngine::Seed()
+{
+    std::fill(bits.begin(), bits.end(), 0);
+    size_t planeBytes = size_t(words + 2) * rows * sizeof(uint64_t);
+    ForEachSlab(scheduler, rules.depth, planeBytes, [&](int begin, int end)
+    {
+        for (int z = begin; z < end; z++)
+        {
+            for (int y = 0; y < int(rules.height); y++)
+            {
+                for (int x = 0; x < int(rules.width); x++)
+                {
+                    size_t index = GetIndex(x / 64 + 1, y + 1, z + 1);
+                    uint64_t bit = uint64_t(IsSeeded(rules, x, y, z)) << (x % 64);
+                    bits[index] |= bit;
+                    bits[index + planeSize] |= bit;
+                }
+            }
+        }
+    });
+}
+
+void BitEngine::Step()
+{
+    if (bits.empty())
+    {
+        return;
+    }
+    if (rules.frame == 0)
+    {
+        Seed();
+        rules.frame++;
+        return;
+    }
+    Refresh();
+    Kernel kernel{bits.data(), nextBits.data(), words, rows, int(rules.width), int(rules.height), planes, planeSize,
+        rules.neighborhood == MOORE, rules.birthMask, rules.surviveMask, rules.life};
+    size_t planeBytes = size_t(words + 2) * rows * sizeof(uint64_t) * (planes + 1);
+    ForEachSlab(scheduler, rules.depth, planeBytes, [&](int begin, int end)
+    {
+        for (int z = begin + 1; z <= end; z++)
+        {
+            stepPlane(kernel, z);
+        }
+    });
+    std::swap(bits, nextBits);
+    rules.frame++;
+}
\ No newline at end of file
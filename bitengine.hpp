@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "engine.hpp"
+#include "rules.hpp"
+#include "scheduler.hpp"
+
+/* bit-sliced cpu engine for moore and von neumann rules, matching Engine (and the gpu) for those,
+ * with an alive bit and the bits of each state in separate planes and x packed into words */
+class BitEngine
+{
+public:
+    /* returns false (and leaves the engine unchanged) for rules it can't run */
+    bool SetRules(const Rules& rules);
+    const Rules& GetRules() const;
+
+    /* seeds on frame 0 like Simulate, otherwise computes the next generation */
+    void Step();
+
+    /* unpacked to bytes on demand */
+    const std::vector<uint8_t>& GetCells();
+    void SetCells(const std::vector<uint8_t>& cells);
+
+    /* steps on the scheduler's threads, or on the calling thread without one */
+    void SetScheduler(Scheduler* scheduler);
+
+private:
+    size_t GetIndex(int w, int y, int z) const;
+    void Seed();
+    void Refresh();
+
+    Rules rules;
+    /* words along x (plus a ghost word on each side), then rows along y (plus a ghost row on each side
+     * and spare rows for the last vector), then planes along z (plus a ghost plane on each side),
+     * the alive bits first and then each of the state's bits */
+    int words{0};
+    int rows{0};
+    int planes{0};
+    size_t planeSize{0};
+    std::vector<uint64_t> bits;
+    std::vector<uint64_t> nextBits;
+    std::vector<uint8_t> cells;
+    Scheduler* scheduler{nullptr};
+};
\ No newline at end of file
@@ -0,0 +1,162 @@
+/* the lanes and the step of one plane for the instruction set in BIT_LANES, included by bitengine.cpp once
+ * per instruction set in its own namespace and target, so there is no pragma once */
+
+/* the words of consecutive rows at the same x, one per lane, so that the neighbors along y are
+ * unaligned loads and the neighbors along x are shifts with the carry from the word beside it */
+static constexpr int LANES = BIT_LANES;
+
+#if BIT_LANES == 8
+struct Lanes
+{
+    __m512i v;
+};
+
+static Lanes Load(const uint64_t* data) { return {_mm512_loadu_si512(data)}; }
+static void Store(uint64_t* data, Lanes a) { _mm512_storeu_si512(data, a.v); }
+static Lanes Broadcast(uint64_t value) { return {_mm512_set1_epi64(int64_t(value))}; }
+static Lanes operator&(Lanes a, Lanes b) { return {_mm512_and_si512(a.v, b.v)}; }
+static Lanes operator|(Lanes a, Lanes b) { return {_mm512_or_si512(a.v, b.v)}; }
+static Lanes operator^(Lanes a, Lanes b) { return {_mm512_xor_si512(a.v, b.v)}; }
+/* zero-masked with every lane set, since gcc's unmasked forms merge into an undefined register and warn */
+static Lanes AndNot(Lanes a, Lanes b) { return {_mm512_maskz_andnot_epi64(0xFF, a.v, b.v)}; }
+static Lanes ShiftLeft(Lanes a, int bits) { return {_mm512_maskz_slli_epi64(0xFF, a.v, bits)}; }
+static Lanes ShiftRight(Lanes a, int bits) { return {_mm512_maskz_srli_epi64(0xFF, a.v, bits)}; }
+#elif BIT_LANES == 4
+struct Lanes
+{
+    __m256i v;
+};
+
+static Lanes Load(const uint64_t* data) { return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data))}; }
+static void Store(uint64_t* data, Lanes a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), a.v); }
+static Lanes Broadcast(uint64_t value) { return {_mm256_set1_epi64x(int64_t(value))}; }
+static Lanes operator&(Lanes a, Lanes b) { return {_mm256_and_si256(a.v, b.v)}; }
+static Lanes operator|(Lanes a, Lanes b) { return {_mm256_or_si256(a.v, b.v)}; }
+static Lanes operator^(Lanes a, Lanes b) { return {_mm256_xor_si256(a.v, b.v)}; }
+static Lanes AndNot(Lanes a, Lanes b) { return {_mm256_andnot_si256(a.v, b.v)}; }
+static Lanes ShiftLeft(Lanes a, int bits) { return {_mm256_slli_epi64(a.v, bits)}; }
+static Lanes ShiftRight(Lanes a, int bits) { return {_mm256_srli_epi64(a.v, bits)}; }
+#else
+struct Lanes
+{
+    uint64_t v;
+};
+
+static Lanes Load(const uint64_t* data) { return {*data}; }
+static void Store(uint64_t* data, Lanes a) { *data = a.v; }
+static Lanes Broadcast(uint64_t value) { return {value}; }
+static Lanes operator&(Lanes a, Lanes b) { return {a.v & b.v}; }
+static Lanes operator|(Lanes a, Lanes b) { return {a.v | b.v}; }
+static Lanes operator^(Lanes a, Lanes b) { return {a.v ^ b.v}; }
+static Lanes AndNot(Lanes a, Lanes b) { return {~a.v & b.v}; }
+static Lanes ShiftLeft(Lanes a, int bits) { return {a.v << bits}; }
+static Lanes ShiftRight(Lanes a, int bits) { return {a.v >> bits}; }
+#endif
+
+/* adds a bit of the given weight (a power of two) to the bit-sliced count */
+static void Add(Lanes count[PLANES], Lanes bit, int weight)
+{
+    for (int i = weight; i < PLANES; i++)
+    {
+        Lanes carry = count[i] & bit;
+        count[i] = count[i] ^ bit;
+        bit = carry;
+    }
+}
+
+/* a full adder of the west, center and east neighbors, added at weights 1 and 2 */
+static void AddRow(Lanes count[PLANES], Lanes west, Lanes center, Lanes east)
+{
+    Lanes half = west ^ center;
+    Lanes sum = half ^ east;
+    Lanes carry = (west & center) | (half & east);
+    Add(count, sum, 0);
+    Add(count, carry, 1);
+}
+
+/* lanes whose count is in the mask */
+static Lanes Match(const Lanes count[PLANES], uint32_t mask)
+{
+    Lanes ones = Broadcast(~uint64_t(0));
+    Lanes match = Broadcast(0);
+    for (int neighbors = 0; neighbors < COUNTS; neighbors++)
+    {
+        if (!((mask >> neighbors) & 1))
+        {
+            continue;
+        }
+        Lanes equal = ones;
+        for (int i = 0; i < PLANES; i++)
+        {
+            equal = (neighbors >> i) & 1 ? equal & count[i] : AndNot(count[i], equal);
+        }
+        match = match | equal;
+    }
+    return match;
+}
+
+static void StepPlane(const Kernel& kernel, int z)
+{
+    Lanes life[STATE_PLANES];
+    for (int plane = 0; plane < kernel.planes; plane++)
+    {
+        life[plane] = Broadcast((kernel.life >> plane) & 1 ? ~uint64_t(0) : 0);
+    }
+    for (int w = 1; w <= kernel.words; w++)
+    {
+        /* the bits past the width stay dead, the torus refresh sets the one it needs */
+        int valid = kernel.width - (w - 1) * 64;
+        Lanes mask = Broadcast(valid >= 64 ? ~uint64_t(0) : (uint64_t(1) << valid) - 1);
+        for (int y = 1; y <= kernel.height; y += LANES)
+        {
+            Lanes count[PLANES];
+            for (int i = 0; i < PLANES; i++)
+            {
+                count[i] = Broadcast(0);
+            }
+            Lanes alive = Load(&kernel.bits[kernel.GetIndex(w, y, z)]);
+            for (int dz = -1; dz <= 1; dz++)
+            {
+                for (int dy = -1; dy <= 1; dy++)
+                {
+                    bool centerRow = dz == 0 && dy == 0;
+                    if (!kernel.moore && dz != 0 && dy != 0)
+                    {
+                        continue;
+                    }
+                    Lanes center = Load(&kernel.bits[kernel.GetIndex(w, y + dy, z + dz)]);
+                    if (!kernel.moore && !centerRow)
+                    {
+                        Add(count, center, 0);
+                        continue;
+                    }
+                    Lanes west = ShiftLeft(center, 1) | ShiftRight(Load(&kernel.bits[kernel.GetIndex(w - 1, y + dy, z + dz)]), 63);
+                    Lanes east = ShiftRight(center, 1) | ShiftLeft(Load(&kernel.bits[kernel.GetIndex(w + 1, y + dy, z + dz)]), 63);
+                    if (centerRow)
+                    {
+                        Add(count, west ^ east, 0);
+                        Add(count, west & east, 1);
+                        continue;
+                    }
+                    AddRow(count, west, center, east);
+                }
+            }
+            /* births jump to life, alive cells that don't survive count down by one, with the
+             * borrow rippling through the state planes */
+            size_t index = kernel.GetIndex(w, y, z);
+            Lanes birth = AndNot(alive, Match(count, kernel.birthMask));
+            Lanes borrow = AndNot(Match(count, kernel.surviveMask), alive);
+            Lanes nextAlive = Broadcast(0);
+            for (int plane = 0; plane < kernel.planes; plane++)
+            {
+                Lanes state = Load(&kernel.bits[index + (plane + 1) * kernel.planeSize]);
+                Lanes next = (birth & life[plane]) | AndNot(birth, state ^ borrow);
+                borrow = AndNot(state, borrow);
+                next = next & mask;
+                nextAlive = nextAlive | next;
+                Store(&kernel.nextBits[index + (plane + 1) * kernel.planeSize], next);
+            }
+            Store(&kernel.nextBits[index], nextAlive);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef BRICKS_GLSL
+#define BRICKS_GLSL
+
+#include "config.hpp"
+
+/* the storage buffer layout keeps a brick of BRICK^3 cells together, bricks in
+ * x, y, z order and the cells of a brick in morton order, one byte per cell */
+
+uint Spread(uint value)
+{
+    return (value & 1u) | ((value & 2u) << 2) | ((value & 4u) << 4);
+}
+
+uint Compact(uint value)
+{
+    return (value & 1u) | ((value >> 2) & 2u) | ((value >> 4) & 4u);
+}
+
+ivec3 GetBrickBounds(ivec3 bounds)
+{
+    return (bounds + BRICK - 1) / BRICK;
+}
+
+uint GetCellIndex(ivec3 id, ivec3 bounds)
+{
+    ivec3 bricks = GetBrickBounds(bounds);
+    ivec3 brick = id / BRICK;
+    uvec3 local = uvec3(id % BRICK);
+    uint morton = Spread(local.x) | (Spread(local.y) << 1) | (Spread(local.z) << 2);
+    return uint(brick.x + (brick.y + brick.z * bricks.y) * bricks.x) * (BRICK * BRICK * BRICK) + morton;
+}
+
+ivec3 GetMortonCell(uint morton)
+{
+    return ivec3(Compact(morton), Compact(morton >> 1), Compact(morton >> 2));
+}
+
+#endif
\ No newline at end of file
@@ -1,13 +1,90 @@
 #ifndef CONFIG_HPP
 #define CONFIG_HPP
 
+/* default grid extent, resizable at runtime */
 #define BOUNDS 128
 #define THREADS 8
-#define FRAMES 2
+/* generations kept in the ring, the newest is drawn while the next one is written */
+#define FRAMES 3
+
+/* temporal blocking tile size (including halo) and maximum generations per dispatch */
+#define TEMPORAL_TILE 16
+#define TEMPORAL_STEPS 4
 
 /* neighborhoods */
 #define MOORE 0
 #define VON_NEUMANN 1
+#define BOX 2
+#define DIAMOND 3
+
+/* transition table rows (states 0..MAX_LIFE) and columns (0..26 neighbors) */
+#define MAX_LIFE 64
+#define COUNTS 27
+
+/* batched universes (see batch.comp), each a cube of the given size */
+#define MAX_UNIVERSES 1024
+#define UNIVERSE_SIZE 64
+
+/* seed cache: most volumes kept, their total size in bytes and how many upcoming seeds are generated ahead */
+#define SEED_CACHE 16
+#define SEED_CACHE_SIZE (256 * 1024 * 1024)
+#define SEED_PREFETCH 2
+
+/* cell layouts, the bricks layout stores BRICK^3 cells in morton order (3 bits per axis) */
+#define LAYOUT_BYTES 0
+#define LAYOUT_NIBBLES 1
+#define LAYOUT_BRICKS 2
+#define BRICK 8
+
+/* the largest workgroup count guaranteed along each axis, the active brick list wraps onto y past it */
+#define MAX_GROUPS 65535
+
+/* dispatches timed per workgroup shape when autotuning, more on small grids so each submission
+ * steps at least AUTOTUNE_CELLS cells and the cpu's share of the time stays small */
+#define AUTOTUNE_STEPS 16
+#define AUTOTUNE_CELLS (256 * 1024 * 1024)
+
+/* statistics: cells each invocation walks along z and downloads in flight */
+#define STATS_CELLS 8
+#define STATS_READBACKS 4
+
+/* what happens once a run dies out, stops changing or repeats a generation among the last HASH_WINDOW measured */
+#define POLICY_OFF 0
+#define POLICY_REPORT 1
+#define POLICY_PAUSE 2
+#define POLICY_RESET 3
+#define HASH_WINDOW 64
+
+/* cpu engines split each generation into slabs of planes of about this size, with at least
+ * this many slabs per thread so there is something left to steal */
+#define SLAB_BYTES (256 * 1024)
+#define SLAB_TASKS 4
+
+/* hashlife node cache size in bytes before garbage collection, and the largest octree (2^level cells a side) */
+#define HASH_MEMORY (1024 * 1024 * 1024)
+#define HASH_LEVELS 60
+
+/* largest radius of the larger than life neighborhoods */
+#define RADIUS 10
+
+/* boundaries */
+#define BOUNDARY_DEAD 0
+#define BOUNDARY_TORUS 1
+
+/* kernels */
+#define KERNEL_DEFAULT 0
+#define KERNEL_TILED 1
+#define KERNEL_BITPLANE 2
+#define KERNEL_BOXSUM 3
+#define KERNEL_TEMPORAL 4
+#define KERNEL_ACTIVE 5
+#define KERNEL_SPLIT 6
+#define KERNEL_LARGER_THAN_LIFE 7
+#define KERNEL_BATCH 8
+#define KERNEL_SEED 9
+#define KERNEL_NIBBLE 10
+#define KERNEL_SUBGROUP 11
+#define KERNEL_BRICKS 12
 
 /* camera */
 #define FOV 1.0f
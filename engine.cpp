@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "engine.hpp"
+#include "scheduler.hpp"
+
+/* _fnlSinglePerlin3D from FastNoiseLite.glsl, with the integer math in uint32_t so overflow wraps like on the GPU */
+static const float Gradients[] =
+{
+    0.f, 1.f, 1.f, 0.f,  0.f,-1.f, 1.f, 0.f,  0.f, 1.f,-1.f, 0.f,  0.f,-1.f,-1.f, 0.f,
+    1.f, 0.f, 1.f, 0.f, -1.f, 0.f, 1.f, 0.f,  1.f, 0.f,-1.f, 0.f, -1.f, 0.f,-1.f, 0.f,
+    1.f, 1.f, 0.f, 0.f, -1.f, 1.f, 0.f, 0.f,  1.f,-1.f, 0.f, 0.f, -1.f,-1.f, 0.f, 0.f,
+    0.f, 1.f, 1.f, 0.f,  0.f,-1.f, 1.f, 0.f,  0.f, 1.f,-1.f, 0.f,  0.f,-1.f,-1.f, 0.f,
+    1.f, 0.f, 1.f, 0.f, -1.f, 0.f, 1.f, 0.f,  1.f, 0.f,-1.f, 0.f, -1.f, 0.f,-1.f, 0.f,
+    1.f, 1.f, 0.f, 0.f, -1.f, 1.f, 0.f, 0.f,  1.f,-1.f, 0.f, 0.f, -1.f,-1.f, 0.f, 0.f,
+    0.f, 1.f, 1.f, 0.f,  0.f,-1.f, 1.f, 0.f,  0.f, 1.f,-1.f, 0.f,  0.f,-1.f,-1.f, 0.f,
+    1.f, 0.f, 1.f, 0.f, -1.f, 0.f, 1.f, 0.f,  1.f, 0.f,-1.f, 0.f, -1.f, 0.f,-1.f, 0.f,
+    1.f, 1.f, 0.f, 0.f, -1.f, 1.f, 0.f, 0.f,  1.f,-1.f, 0.f, 0.f, -1.f,-1.f, 0.f, 0.f,
+    0.f, 1.f, 1.f, 0.f,  0.f,-1.f, 1.f, 0.f,  0.f, 1.f,-1.f, 0.f,  0.f,-1.f,-1.f, 0.f,
+    1.f, 0.f, 1.f, 0.f, -1.f, 0.f, 1.f, 0.f,  1.f, 0.f,-1.f, 0.f, -1.f, 0.f,-1.f, 0.f,
+    1.f, 1.f, 0.f, 0.f, -1.f, 1.f, 0.f, 0.f,  1.f,-1.f, 0.f, 0.f, -1.f,-1.f, 0.f, 0.f,
+    0.f, 1.f, 1.f, 0.f,  0.f,-1.f, 1.f, 0.f,  0.f, 1.f,-1.f, 0.f,  0.f,-1.f,-1.f, 0.f,
+    1.f, 0.f, 1.f, 0.f, -1.f, 0.f, 1.f, 0.f,  1.f, 0.f,-1.f, 0.f, -1.f, 0.f,-1.f, 0.f,
+    1.f, 1.f, 0.f, 0.f, -1.f, 1.f, 0.f, 0.f,  1.f,-1.f, 0.f, 0.f, -1.f,-1.f, 0.f, 0.f,
+    1.f, 1.f, 0.f, 0.f,  0.f,-1.f, 1.f, 0.f, -1.f, 1.f, 0.f, 0.f,  0.f,-1.f,-1.f, 0.f
+};
+
+static const int PrimeX = 501125321;
+static const int PrimeY = 1136930381;
+static const int PrimeZ = 1720413743;
+
+static float Lerp(float a, float b, float t)
+{
+    /* glsl's mix */
+    return a * (1.0f - t) + b * t;
+}
+
+static float InterpQuintic(float t)
+{
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+static int Multiply(int a, int b)
+{
+    return int(uint32_t(a) * uint32_t(b));
+}
+
+static float GradCoord(int seed, int xPrimed, int yPrimed, int zPrimed, float xd, float yd, float zd)
+{
+    int hash = Multiply(seed ^ xPrimed ^ yPrimed ^ zPrimed, 0x27d4eb2d);
+    hash ^= hash >> 15;
+    hash &= 63 << 2;
+    return xd * Gradients[hash] + yd * Gradients[hash | 1] + zd * Gradients[hash | 2];
+}
+
+static float Perlin(int seed, float x, float y, float z)
+{
+    int x0 = int(std::floor(x));
+    int y0 = int(std::floor(y));
+    int z0 = int(std::floor(z));
+    float xd0 = x - float(x0);
+    float yd0 = y - float(y0);
+    float zd0 = z - float(z0);
+    float xd1 = xd0 - 1.0f;
+    float yd1 = yd0 - 1.0f;
+    float zd1 = zd0 - 1.0f;
+    float xs = InterpQuintic(xd0);
+    float ys = InterpQuintic(yd0);
+    float zs = InterpQuintic(zd0);
+    x0 = Multiply(x0, PrimeX);
+    y0 = Multiply(y0, PrimeY);
+    z0 = Multiply(z0, PrimeZ);
+    int x1 = int(uint32_t(x0) + uint32_t(PrimeX));
+    int y1 = int(uint32_t(y0) + uint32_t(PrimeY));
+    int z1 = int(uint32_t(z0) + uint32_t(PrimeZ));
+    float xf00 = Lerp(GradCoord(seed, x0, y0, z0, xd0, yd0, zd0), GradCoord(seed, x1, y0, z0, xd1, yd0, zd0), xs);
+    float xf10 = Lerp(GradCoord(seed, x0, y1, z0, xd0, yd1, zd0), GradCoord(seed, x1, y1, z0, xd1, yd1, zd0), xs);
+    float xf01 = Lerp(GradCoord(seed, x0, y0, z1, xd0, yd0, zd1), GradCoord(seed, x1, y0, z1, xd1, yd0, zd1), xs);
+    float xf11 = Lerp(GradCoord(seed, x0, y1, z1, xd0, yd1, zd1), GradCoord(seed, x1, y1, z1, xd1, yd1, zd1), xs);
+    float yf0 = Lerp(xf00, xf10, ys);
+    float yf1 = Lerp(xf01, xf11, ys);
+    return Lerp(yf0, yf1, zs) * 0.964921414852142333984375f;
+}
+
+/* the cells within r of center along an axis, as one interval or two when it wraps (see ltl.comp) */
+static int GetIntervals(int center, int r, int size, bool torus, int intervals[2][2])
+{
+    if (!torus)
+    {
+        intervals[0][0] = std::max(center - r, 0);
+        intervals[0][1] = std::min(center + r, size - 1);
+        return 1;
+    }
+    if (2 * r + 1 >= size)
+    {
+        intervals[0][0] = 0;
+        intervals[0][1] = size - 1;
+        return 1;
+    }
+    int lo = center - r;
+    int hi = center + r;
+    if (lo < 0)
+    {
+        intervals[0][0] = lo + size;
+        intervals[0][1] = size - 1;
+        intervals[1][0] = 0;
+        intervals[1][1] = hi;
+        return 2;
+    }
+    if (hi >= size)
+    {
+        intervals[0][0] = lo;
+        intervals[0][1] = size - 1;
+        intervals[1][0] = 0;
+        intervals[1][1] = hi - size;
+        return 2;
+    }
+    intervals[0][0] = lo;
+    intervals[0][1] = hi;
+    return 1;
+}
+
+void Engine::SetRules(const Rules& newRules)
+{
+    bool resized = newRules.width != rules.width || newRules.height != rules.height || newRules.depth != rules.depth;
+    rules = newRules;
+    size_t size = size_t(rules.width) * rules.height * rules.depth;
+    if (resized || cells.size() != size)
+    {
+        cells.assign(size, 0);
+        nextCells.assign(size, 0);
+    }
+}
+
+const Rules& Engine::GetRules() const
+{
+    return rules;
+}
+
+const std::vector<uint8_t>& Engine::GetCells() const
+{
+    return cells;
+}
+
+void Engine::SetCells(const std::vector<uint8_t>& newCells)
+{
+    if (newCells.size() == cells.size())
+    {
+        cells = newCells;
+    }
+}
+
+void Engine::SetScheduler(Scheduler* newScheduler)
+{
+    scheduler = newScheduler;
+}
+
+int Engine::GetIndex(int x, int y, int z) const
+{
+    return x + rules.width * (y + rules.height * z);
+}
+
+/* wraps the position on a torus, otherwise returns false if it's past the dead boundary */
+bool Engine::ApplyBoundary(int& x, int& y, int& z) const
+{
+    int width = rules.width;
+    int height = rules.height;
+    int depth = rules.depth;
+    if (rules.boundary == BOUNDARY_TORUS)
+    {
+        x = (x % width + width) % width;
+        y = (y % height + height) % height;
+        z = (z % depth + depth) % depth;
+        return true;
+    }
+    return x >= 0 && y >= 0 && z >= 0 && x < width && y < height && z < depth;
+}
+
+bool IsSeeded(const Rules& rules, int x, int y, int z)
+{
+    float value = Perlin(int(rules.seed), float(x) * rules.frequency,
+        float(y) * rules.frequency, float(z) * rules.frequency);
+    return value > rules.threshold;
+}
+
+void Engine::Seed()
+{
+    ForEachSlab(scheduler, rules.depth, size_t(rules.width) * rules.height, [&](int begin, int end)
+    {
+        for (int z = begin; z < end; z++)
+        {
+            for (int y = 0; y < int(rules.height); y++)
+            {
+                for (int x = 0; x < int(rules.width); x++)
+                {
+                    cells[GetIndex(x, y, z)] = IsSeeded(rules, x, y, z);
+                }
+            }
+        }
+    });
+}
+
+/* the radius 1 neighborhoods, counting a neighbor twice when a small torus wraps onto it like automata.comp */
+uint32_t Engine::CountNeighbors(int x, int y, int z) const
+{
+    uint32_t neighbors = 0;
+    for (int dz = -1; dz <= 1; dz++)
+    {
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                int distance = std::abs(dx) + std::abs(dy) + std::abs(dz);
+                if (distance == 0 || (rules.neighborhood == VON_NEUMANN && distance > 1))
+                {
+                    continue;
+                }
+                int nx = x + dx;
+                int ny = y + dy;
+                int nz = z + dz;
+                if (!ApplyBoundary(nx, ny, nz))
+                {
+                    continue;
+                }
+                neighbors += cells[GetIndex(nx, ny, nz)] > 0;
+            }
+        }
+    }
+    return neighbors;
+}
+
+/* every cell within the box once, including the center */
+uint32_t Engine::CountBox(int x, int y, int z) const
+{
+    bool torus = rules.boundary == BOUNDARY_TORUS;
+    int r = rules.radius;
+    int xs[2][2];
+    int ys[2][2];
+    int zs[2][2];
+    int nx = GetIntervals(x, r, rules.width, torus, xs);
+    int ny = GetIntervals(y, r, rules.height, torus, ys);
+    int nz = GetIntervals(z, r, rules.depth, torus, zs);
+    uint32_t sum = 0;
+    for (int k = 0; k < nz; k++)
+    for (int j = 0; j < ny; j++)
+    for (int i = 0; i < nx; i++)
+    {
+        for (int cz = zs[k][0]; cz <= zs[k][1]; cz++)
+        for (int cy = ys[j][0]; cy <= ys[j][1]; cy++)
+        for (int cx = xs[i][0]; cx <= xs[i][1]; cx++)
+        {
+            sum += cells[GetIndex(cx, cy, cz)] > 0;
+        }
+    }
+    return sum;
+}
+
+/* rows of the octahedron like ltl.comp, which wraps rows but clamps each row to the grid once */
+uint32_t Engine::CountDiamond(int x, int y, int z) const
+{
+    bool torus = rules.boundary == BOUNDARY_TORUS;
+    int r = rules.radius;
+    uint32_t sum = 0;
+    for (int dz = -r; dz <= r; dz++)
+    {
+        int ry = r - std::abs(dz);
+        for (int dy = -ry; dy <= ry; dy++)
+        {
+            int rowX = x;
+            int rowY = y + dy;
+            int rowZ = z + dz;
+            if (!ApplyBoundary(rowX, rowY, rowZ))
+            {
+                continue;
+            }
+            int xs[2][2];
+            int nx = GetIntervals(x, ry - std::abs(dy), rules.width, torus, xs);
+            for (int i = 0; i < nx; i++)
+            {
+                for (int cx = xs[i][0]; cx <= xs[i][1]; cx++)
+                {
+                    sum += cells[GetIndex(cx, rowY, rowZ)] > 0;
+                }
+            }
+        }
+    }
+    return sum;
+}
+
+void Engine::Step()
+{
+    if (cells.empty())
+    {
+        return;
+    }
+    if (rules.frame == 0)
+    {
+        Seed();
+        rules.frame++;
+        return;
+    }
+    ForEachSlab(scheduler, rules.depth, size_t(rules.width) * rules.height, [&](int begin, int end)
+    {
+        for (int z = begin; z < end; z++)
+        {
+            for (int y = 0; y < int(rules.height); y++)
+            {
+                for (int x = 0; x < int(rules.width); x++)
+                {
+                    int value = cells[GetIndex(x, y, z)];
+                    bool birth;
+                    bool survive;
+                    if (rules.neighborhood == BOX || rules.neighborhood == DIAMOND)
+                    {
+                        uint32_t neighbors = rules.neighborhood == BOX ? CountBox(x, y, z) : CountDiamond(x, y, z);
+                        neighbors -= value > 0;
+                        birth = neighbors >= rules.birthMin && neighbors <= rules.birthMax;
+                        survive = neighbors >= rules.surviveMin && neighbors <= rules.surviveMax;
+                    }
+                    else
+                    {
+                        uint32_t neighbors = CountNeighbors(x, y, z);
+                        birth = (rules.birthMask >> neighbors) & 1;
+                        survive = (rules.surviveMask >> neighbors) & 1;
+                    }
+                    /* Transition in automata.glsl */
+                    if (value == 0 && birth)
+                    {
+                        value = rules.life;
+                    }
+                    else if (!survive)
+                    {
+                        value--;
+                    }
+                    nextCells[GetIndex(x, y, z)] = std::max(0, value);
+                }
+            }
+        }
+    });
+    std::swap(cells, nextCells);
+    rules.frame++;
+}
\ No newline at end of file
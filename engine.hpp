@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "rules.hpp"
+#include "scheduler.hpp"
+
+/* whether seed.comp makes the cell alive (with a state of 1) */
+bool IsSeeded(const Rules& rules, int x, int y, int z);
+
+/* cpu reference of seed.comp, automata.comp and ltl.comp, with one byte per cell in x, y, z order like the textures */
+class Engine
+{
+public:
+    /* the grid is cleared when the size changes */
+    void SetRules(const Rules& rules);
+    const Rules& GetRules() const;
+
+    /* seeds on frame 0 like Simulate, otherwise computes the next generation */
+    void Step();
+
+    const std::vector<uint8_t>& GetCells() const;
+    /* continues from another grid of the same size, e.g. one read back from the GPU */
+    void SetCells(const std::vector<uint8_t>& cells);
+
+    /* steps on the scheduler's threads, or on the calling thread without one */
+    void SetScheduler(Scheduler* scheduler);
+
+private:
+    void Seed();
+    int GetIndex(int x, int y, int z) const;
+    bool ApplyBoundary(int& x, int& y, int& z) const;
+    uint32_t CountNeighbors(int x, int y, int z) const;
+    uint32_t CountBox(int x, int y, int z) const;
+    uint32_t CountDiamond(int x, int y, int z) const;
+
+    Rules rules;
+    std::vector<uint8_t> cells;
+    std::vector<uint8_t> nextCells;
+    Scheduler* scheduler{nullptr};
+};
\ No newline at end of file
@@ -0,0 +1,692 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "engine.hpp"
+#include "hashengine.hpp"
+#include "scheduler.hpp"
+
+static size_t Mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return size_t(value);
+}
+
+static size_t HashChildren(const uint32_t children[8])
+{
+    uint64_t hash = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        hash = (hash ^ children[i]) * 0x9e3779b97f4a7c15ull;
+    }
+    return Mix(hash);
+}
+
+/* the cell at x, y, z (each 0 to 3) of a leaf */
+static int GetBit(int x, int y, int z)
+{
+    return x + 4 * y + 16 * z;
+}
+
+/* the next generation of the inside of a cube of size^3 cells in x, y, z order, which is size - 2 a side */
+static void StepCube(const Rules& rules, const uint8_t* in, int size, uint8_t* out)
+{
+    int inside = size - 2;
+    for (int z = 0; z < inside; z++)
+    for (int y = 0; y < inside; y++)
+    for (int x = 0; x < inside; x++)
+    {
+        uint32_t neighbors = 0;
+        for (int dz = -1; dz <= 1; dz++)
+        for (int dy = -1; dy <= 1; dy++)
+        for (int dx = -1; dx <= 1; dx++)
+        {
+            int distance = std::abs(dx) + std::abs(dy) + std::abs(dz);
+            if (distance == 0 || (rules.neighborhood == VON_NEUMANN && distance > 1))
+            {
+                continue;
+            }
+            neighbors += in[(x + 1 + dx) + size * ((y + 1 + dy) + size * (z + 1 + dz))];
+        }
+        /* Transition in automata.glsl with a life of 1 */
+        bool alive = in[(x + 1) + size * ((y + 1) + size * (z + 1))];
+        uint32_t mask = alive ? rules.surviveMask : rules.birthMask;
+        out[x + inside * (y + inside * z)] = (mask >> neighbors) & 1;
+    }
+}
+
+bool HashEngine::SetRules(const Rules& newRules)
+{
+    /* births with no neighbors would fill the unbounded grid and a torus has no outside */
+    if (newRules.life != 1 || newRules.neighborhood > VON_NEUMANN ||
+        newRules.boundary != BOUNDARY_DEAD || (newRules.birthMask & 1))
+    {
+        return false;
+    }
+    bool resized = newRules.width != rules.width || newRules.height != rules.height ||
+        newRules.depth != rules.depth || !root;
+    bool changed = newRules.surviveMask != rules.surviveMask || newRules.birthMask != rules.birthMask ||
+        newRules.neighborhood != rules.neighborhood;
+    rules = newRules;
+    if (rules.frame != uint32_t(generation))
+    {
+        generation = rules.frame;
+    }
+    if (changed)
+    {
+        ClearResults(0);
+    }
+    if (resized)
+    {
+        root = GetEmpty(GetBoxLevel());
+        stack.clear();
+    }
+    return true;
+}
+
+const Rules& HashEngine::GetRules() const
+{
+    return rules;
+}
+
+uint64_t HashEngine::GetGeneration() const
+{
+    return generation;
+}
+
+uint64_t HashEngine::GetPopulation() const
+{
+    return nodes[root].population;
+}
+
+void HashEngine::SetMemory(size_t bytes)
+{
+    capacity = bytes / (sizeof(Node) + sizeof(uint32_t));
+    limit = capacity;
+}
+
+size_t HashEngine::GetNodes() const
+{
+    return nodes.size() - 1 - freeCount;
+}
+
+void HashEngine::SetScheduler(Scheduler* newScheduler)
+{
+    scheduler = newScheduler;
+}
+
+/* takes a free node, collecting garbage first once the cache is full */
+uint32_t HashEngine::Allocate()
+{
+    if (!freeNodes && nodes.size() >= limit)
+    {
+        Collect();
+    }
+    uint32_t node = freeNodes;
+    if (node)
+    {
+        freeNodes = nodes[node].next;
+        freeCount--;
+    }
+    else
+    {
+        node = uint32_t(nodes.size());
+        nodes.emplace_back();
+    }
+    /* before the node is filled in, so rehashing doesn't link it */
+    if (GetNodes() > buckets.size())
+    {
+        Rehash(buckets.size() * 2);
+    }
+    return node;
+}
+
+/* links a new node into its bucket and keeps it through collections until the current jump ends */
+uint32_t HashEngine::Insert(uint32_t node, size_t hash)
+{
+    size_t bucket = hash & (buckets.size() - 1);
+    nodes[node].next = buckets[bucket];
+    buckets[bucket] = node;
+    stack.push_back(node);
+    return node;
+}
+
+uint32_t HashEngine::GetLeaf(uint64_t bits)
+{
+    size_t hash = Mix(bits);
+    for (uint32_t node = buckets[hash & (buckets.size() - 1)]; node; node = nodes[node].next)
+    {
+        if (nodes[node].level == 2 && nodes[node].bits == bits)
+        {
+            stack.push_back(node);
+            return node;
+        }
+    }
+    uint32_t node = Allocate();
+    nodes[node] = Node{};
+    nodes[node].bits = bits;
+    nodes[node].population = std::popcount(bits);
+    nodes[node].level = 2;
+    return Insert(node, hash);
+}
+
+uint32_t HashEngine::GetNode(const uint32_t children[8])
+{
+    size_t hash = HashChildren(children);
+    for (uint32_t node = buckets[hash & (buckets.size() - 1)]; node; node = nodes[node].next)
+    {
+        if (nodes[node].level > 2 && !std::memcmp(nodes[node].children, children, sizeof(nodes[node].children)))
+        {
+            stack.push_back(node);
+            return node;
+        }
+    }
+    /* the children may live in the nodes, which allocating can move */
+    uint32_t copy[8];
+    std::memcpy(copy, children, sizeof(copy));
+    uint32_t node = Allocate();
+    nodes[node] = Node{};
+    std::memcpy(nodes[node].children, copy, sizeof(copy));
+    uint64_t population = 0;
+    for (uint32_t child : copy)
+    {
+        /* stops growing instead of wrapping for huge full regions, since it only has to stay nonzero */
+        population = std::max(population, population + nodes[child].population);
+    }
+    nodes[node].population = population;
+    nodes[node].level = nodes[copy[0]].level + 1;
+    return Insert(node, hash);
+}
+
+uint32_t HashEngine::GetEmpty(int level)
+{
+    while (int(empties.size()) <= level)
+    {
+        int next = int(empties.size());
+        uint32_t empty = 0;
+        if (next == 2)
+        {
+            empty = GetLeaf(0);
+        }
+        else if (next > 2)
+        {
+            uint32_t children[8];
+            std::fill(children, children + 8, empties[next - 1]);
+            empty = GetNode(children);
+        }
+        empties.push_back(empty);
+    }
+    return empties[level];
+}
+
+/* the inner half of a node, one level down */
+uint32_t HashEngine::GetCenter(uint32_t node)
+{
+    const Node& parent = nodes[node];
+    if (parent.level > 3)
+    {
+        uint32_t children[8];
+        for (int i = 0; i < 8; i++)
+        {
+            children[i] = nodes[parent.children[i]].children[7 - i];
+        }
+        return GetNode(children);
+    }
+    uint64_t bits = 0;
+    for (int z = 0; z < 4; z++)
+    for (int y = 0; y < 4; y++)
+    for (int x = 0; x < 4; x++)
+    {
+        int i = (x + 2) / 4 + (y + 2) / 4 * 2 + (z + 2) / 4 * 4;
+        uint64_t leaf = nodes[parent.children[i]].bits;
+        bits |= ((leaf >> GetBit((x + 2) % 4, (y + 2) % 4, (z + 2) % 4)) & 1) << GetBit(x, y, z);
+    }
+    return GetLeaf(bits);
+}
+
+/* the inner 4^3 cells of a node of 8^3 cells after one or two generations, stepped directly */
+uint64_t HashEngine::StepLeaves(uint32_t node, int generations) const
+{
+    uint8_t cube[8 * 8 * 8];
+    const Node& parent = nodes[node];
+    for (int i = 0; i < 8; i++)
+    {
+        uint64_t leaf = nodes[parent.children[i]].bits;
+        for (int z = 0; z < 4; z++)
+        for (int y = 0; y < 4; y++)
+        for (int x = 0; x < 4; x++)
+        {
+            int cx = x + (i & 1) * 4;
+            int cy = y + (i >> 1 & 1) * 4;
+            int cz = z + (i >> 2) * 4;
+            cube[cx + 8 * (cy + 8 * cz)] = (leaf >> GetBit(x, y, z)) & 1;
+        }
+    }
+    uint8_t next[6 * 6 * 6];
+    uint8_t last[4 * 4 * 4];
+    StepCube(rules, cube, 8, next);
+    if (generations == 2)
+    {
+        StepCube(rules, next, 6, last);
+    }
+    else
+    {
+        for (int z = 0; z < 4; z++)
+        for (int y = 0; y < 4; y++)
+        for (int x = 0; x < 4; x++)
+        {
+            last[GetBit(x, y, z)] = next[(x + 1) + 6 * ((y + 1) + 6 * (z + 1))];
+        }
+    }
+    uint64_t bits = 0;
+    for (int i = 0; i < 64; i++)
+    {
+        bits |= uint64_t(last[i]) << i;
+    }
+    return bits;
+}
+
+/* the center of a node after 2^(level - 2) generations, or 2^exponent when that's fewer, from the
+ * results of the 27 overlapping nodes one level down (or their centers when slower) and then of the
+ * 8 nodes those make up */
+uint32_t HashEngine::GetResult(uint32_t node)
+{
+    if (nodes[node].result)
+    {
+        return nodes[node].result;
+    }
+    size_t top = stack.size();
+    int level = nodes[node].level;
+    uint32_t result;
+    if (!nodes[node].population)
+    {
+        result = GetEmpty(level - 1);
+    }
+    else if (level == 3)
+    {
+        result = GetLeaf(StepLeaves(node, exponent > 0 ? 2 : 1));
+    }
+    else
+    {
+        bool slow = level - 2 > exponent;
+        uint32_t grid[4][4][4];
+        for (int i = 0; i < 8; i++)
+        {
+            const Node& child = nodes[nodes[node].children[i]];
+            for (int j = 0; j < 8; j++)
+            {
+                int x = (i & 1) * 2 + (j & 1);
+                int y = (i >> 1 & 1) * 2 + (j >> 1 & 1);
+                int z = (i >> 2) * 2 + (j >> 2);
+                grid[z][y][x] = child.children[j];
+            }
+        }
+        uint32_t middle[3][3][3];
+        for (int z = 0; z < 3; z++)
+        for (int y = 0; y < 3; y++)
+        for (int x = 0; x < 3; x++)
+        {
+            uint32_t children[8];
+            for (int i = 0; i < 8; i++)
+            {
+                children[i] = grid[z + (i >> 2)][y + (i >> 1 & 1)][x + (i & 1)];
+            }
+            uint32_t sub = GetNode(children);
+            middle[z][y][x] = slow ? GetCenter(sub) : GetResult(sub);
+        }
+        uint32_t children[8];
+        for (int i = 0; i < 8; i++)
+        {
+            uint32_t quarter[8];
+            for (int j = 0; j < 8; j++)
+            {
+                quarter[j] = middle[(i >> 2) + (j >> 2)][(i >> 1 & 1) + (j >> 1 & 1)][(i & 1) + (j & 1)];
+            }
+            children[i] = GetResult(GetNode(quarter));
+        }
+        result = GetNode(children);
+    }
+    nodes[node].result = result;
+    stack.resize(top);
+    stack.push_back(result);
+    return result;
+}
+
+/* the same cells in a node twice the size */
+uint32_t HashEngine::Expand(uint32_t node)
+{
+    uint32_t empty = GetEmpty(nodes[node].level - 1);
+    uint32_t old[8];
+    std::memcpy(old, nodes[node].children, sizeof(old));
+    uint32_t children[8];
+    for (int i = 0; i < 8; i++)
+    {
+        uint32_t inner[8];
+        std::fill(inner, inner + 8, empty);
+        inner[7 - i] = old[i];
+        children[i] = GetNode(inner);
+    }
+    return GetNode(children);
+}
+
+/* whether every cell is in the inner quarter, so the result can hold whatever grows from it */
+bool HashEngine::IsCentered(uint32_t node) const
+{
+    const Node& parent = nodes[node];
+    for (int i = 0; i < 8; i++)
+    {
+        const Node& child = nodes[parent.children[i]];
+        for (int j = 0; j < 8; j++)
+        {
+            const Node& grandchild = nodes[child.children[j]];
+            if (j != 7 - i)
+            {
+                if (grandchild.population)
+                {
+                    return false;
+                }
+                continue;
+            }
+            for (int k = 0; k < 8; k++)
+            {
+                if (k != 7 - i && nodes[grandchild.children[k]].population)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/* steps 2^exponent generations, returning false when the pattern outgrew HASH_LEVELS */
+bool HashEngine::Jump(int newExponent)
+{
+    SetExponent(newExponent);
+    collected = false;
+    int level = std::max(exponent + 3, 5);
+    while (nodes[root].level < level || !IsCentered(root))
+    {
+        if (nodes[root].level >= HASH_LEVELS)
+        {
+            stack.clear();
+            return false;
+        }
+        root = Expand(root);
+    }
+    root = GetResult(root);
+    stack.clear();
+    generation += uint64_t(1) << exponent;
+    return true;
+}
+
+/* the results above 2^exponent generations depend on it */
+void HashEngine::SetExponent(int newExponent)
+{
+    if (newExponent != exponent)
+    {
+        ClearResults(std::min(newExponent, exponent) + 2);
+        exponent = newExponent;
+    }
+}
+
+void HashEngine::ClearResults(int level)
+{
+    for (Node& node : nodes)
+    {
+        if (node.level > level)
+        {
+            node.result = 0;
+        }
+    }
+}
+
+void HashEngine::Rehash(size_t size)
+{
+    buckets.assign(size, 0);
+    for (uint32_t node = 1; node < nodes.size(); node++)
+    {
+        if (!nodes[node].level)
+        {
+            continue;
+        }
+        size_t hash = nodes[node].level == 2 ? Mix(nodes[node].bits) : HashChildren(nodes[node].children);
+        size_t bucket = hash & (size - 1);
+        nodes[node].next = buckets[bucket];
+        buckets[bucket] = node;
+    }
+}
+
+void HashEngine::Mark(uint32_t node, bool results)
+{
+    if (!node || nodes[node].marked)
+    {
+        return;
+    }
+    nodes[node].marked = true;
+    if (nodes[node].level > 2)
+    {
+        for (uint32_t child : nodes[node].children)
+        {
+            Mark(child, results);
+        }
+    }
+    if (results)
+    {
+        Mark(nodes[node].result, results);
+    }
+}
+
+/* frees every node the root, the empty nodes and the nodes being computed don't reach, keeping their
+ * results unless that keeps more than half the cache, and keeping them anyway (letting the cache grow)
+ * when even the pattern takes more than half or the jump already collected, since recomputing would thrash */
+void HashEngine::Collect()
+{
+    auto mark = [&](bool results)
+    {
+        for (Node& node : nodes)
+        {
+            node.marked = false;
+        }
+        Mark(root, results);
+        for (uint32_t node : empties)
+        {
+            Mark(node, results);
+        }
+        for (uint32_t node : stack)
+        {
+            Mark(node, results);
+        }
+        return size_t(std::count_if(nodes.begin(), nodes.end(), [](const Node& node) { return node.marked; }));
+    };
+    size_t live = mark(true);
+    if (live > capacity / 2 && !collected)
+    {
+        size_t pattern = mark(false);
+        live = pattern > capacity / 2 ? mark(true) : pattern;
+    }
+    freeNodes = 0;
+    freeCount = 0;
+    /* backwards so the lowest nodes are reused first */
+    for (uint32_t node = uint32_t(nodes.size() - 1); node > 0; node--)
+    {
+        if (!nodes[node].marked)
+        {
+            nodes[node].level = 0;
+            nodes[node].result = 0;
+            nodes[node].next = freeNodes;
+            freeNodes = node;
+            freeCount++;
+        }
+        else if (!nodes[nodes[node].result].marked)
+        {
+            nodes[node].result = 0;
+        }
+    }
+    Rehash(buckets.size());
+    limit = std::max(capacity, live * 2);
+    collected = true;
+}
+
+/* the smallest root holding the box in its positive octant */
+int HashEngine::GetBoxLevel() const
+{
+    uint32_t size = std::max({rules.width, rules.height, rules.depth});
+    return std::max(5, int(std::bit_width(size - 1)) + 1);
+}
+
+/* builds a node from the leaves covering the box, whose corner is at x, y, z */
+uint32_t HashEngine::Build(int level, int64_t x, int64_t y, int64_t z, const std::vector<uint64_t>& leaves)
+{
+    int64_t size = int64_t(1) << level;
+    if (x >= rules.width || y >= rules.height || z >= rules.depth || x + size <= 0 || y + size <= 0 || z + size <= 0)
+    {
+        return GetEmpty(level);
+    }
+    if (level == 2)
+    {
+        int64_t leavesX = (rules.width + 3) / 4;
+        int64_t leavesY = (rules.height + 3) / 4;
+        return GetLeaf(leaves[x / 4 + leavesX * (y / 4 + leavesY * (z / 4))]);
+    }
+    int64_t half = size / 2;
+    uint32_t children[8];
+    for (int i = 0; i < 8; i++)
+    {
+        children[i] = Build(level - 1, x + (i & 1) * half, y + (i >> 1 & 1) * half, z + (i >> 2) * half, leaves);
+    }
+    return GetNode(children);
+}
+
+void HashEngine::Seed()
+{
+    int leavesX = (rules.width + 3) / 4;
+    int leavesY = (rules.height + 3) / 4;
+    int leavesZ = (rules.depth + 3) / 4;
+    std::vector<uint64_t> leaves(size_t(leavesX) * leavesY * leavesZ, 0);
+    ForEachSlab(scheduler, leavesZ, size_t(leavesX) * leavesY * sizeof(uint64_t), [&](int begin, int end)
+    {
+        for (int z = begin * 4; z < std::min(end * 4, int(rules.depth)); z++)
+        {
+            for (int y = 0; y < int(rules.height); y++)
+            {
+                for (int x = 0; x < int(rules.width); x++)
+                {
+                    if (IsSeeded(rules, x, y, z))
+                    {
+                        leaves[x / 4 + leavesX * (y / 4 + size_t(leavesY) * (z / 4))] |= uint64_t(1) << GetBit(x % 4, y % 4, z % 4);
+                    }
+                }
+            }
+        }
+    });
+    int level = GetBoxLevel();
+    int64_t corner = -(int64_t(1) << (level - 1));
+    root = Build(level, corner, corner, corner, leaves);
+    stack.clear();
+}
+
+void HashEngine::SetCells(const std::vector<uint8_t>& newCells)
+{
+    if (newCells.size() != size_t(rules.width) * rules.height * rules.depth)
+    {
+        return;
+    }
+    int leavesX = (rules.width + 3) / 4;
+    int leavesY = (rules.height + 3) / 4;
+    int leavesZ = (rules.depth + 3) / 4;
+    std::vector<uint64_t> leaves(size_t(leavesX) * leavesY * leavesZ, 0);
+    size_t i = 0;
+    for (int z = 0; z < int(rules.depth); z++)
+    {
+        for (int y = 0; y < int(rules.height); y++)
+        {
+            for (int x = 0; x < int(rules.width); x++, i++)
+            {
+                if (newCells[i])
+                {
+                    leaves[x / 4 + leavesX * (y / 4 + size_t(leavesY) * (z / 4))] |= uint64_t(1) << GetBit(x % 4, y % 4, z % 4);
+                }
+            }
+        }
+    }
+    int level = GetBoxLevel();
+    int64_t corner = -(int64_t(1) << (level - 1));
+    root = Build(level, corner, corner, corner, leaves);
+    stack.clear();
+}
+
+/* writes the alive cells of a node whose corner is at x, y, z that are in the box */
+void HashEngine::Extract(uint32_t node, int64_t x, int64_t y, int64_t z)
+{
+    const Node& parent = nodes[node];
+    int64_t size = int64_t(1) << parent.level;
+    if (!parent.population || x >= rules.width || y >= rules.height || z >= rules.depth ||
+        x + size <= 0 || y + size <= 0 || z + size <= 0)
+    {
+        return;
+    }
+    if (parent.level == 2)
+    {
+        for (uint64_t bits = parent.bits; bits; bits &= bits - 1)
+        {
+            int bit = std::countr_zero(bits);
+            int64_t cx = x + (bit & 3);
+            int64_t cy = y + (bit >> 2 & 3);
+            int64_t cz = z + (bit >> 4);
+            if (cx >= 0 && cy >= 0 && cz >= 0 && cx < rules.width && cy < rules.height && cz < rules.depth)
+            {
+                cells[cx + rules.width * (cy + size_t(rules.height) * cz)] = 1;
+            }
+        }
+        return;
+    }
+    int64_t half = size / 2;
+    for (int i = 0; i < 8; i++)
+    {
+        Extract(parent.children[i], x + (i & 1) * half, y + (i >> 1 & 1) * half, z + (i >> 2) * half);
+    }
+}
+
+const std::vector<uint8_t>& HashEngine::GetCells()
+{
+    cells.assign(size_t(rules.width) * rules.height * rules.depth, 0);
+    int64_t corner = -(int64_t(1) << (nodes[root].level - 1));
+    Extract(root, corner, corner, corner);
+    return cells;
+}
+
+void HashEngine::Advance(uint64_t generations)
+{
+    if (!root || !generations)
+    {
+        return;
+    }
+    if (generation == 0)
+    {
+        Seed();
+        generation++;
+        generations--;
+    }
+    while (generations)
+    {
+        int newExponent = std::min(int(std::bit_width(generations)) - 1, HASH_LEVELS - 3);
+        if (!Jump(newExponent))
+        {
+            break;
+        }
+        generations -= uint64_t(1) << newExponent;
+    }
+    rules.frame = uint32_t(generation);
+}
+
+void HashEngine::Step()
+{
+    Advance(1);
+}
\ No newline at end of file
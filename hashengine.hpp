@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "rules.hpp"
+#include "scheduler.hpp"
+
+/* hashlife over a hash-consed octree for binary moore and von neumann rules on an unbounded grid,
+ * matching Engine (and the gpu) in the box from the origin to the grid size while nothing leaves it */
+class HashEngine
+{
+public:
+    /* returns false (and leaves the engine unchanged) for rules it can't run */
+    bool SetRules(const Rules& rules);
+    const Rules& GetRules() const;
+
+    /* seeds on frame 0 like Simulate, otherwise computes the next generation */
+    void Step();
+    /* steps that many generations, in jumps of powers of two */
+    void Advance(uint64_t generations);
+    uint64_t GetGeneration() const;
+
+    /* the cells in the box, unpacked on demand */
+    const std::vector<uint8_t>& GetCells();
+    void SetCells(const std::vector<uint8_t>& cells);
+    /* alive cells in the whole universe, which is more than in the box once something escapes it */
+    uint64_t GetPopulation() const;
+
+    /* nodes are garbage collected once the cache reaches this many bytes, which it only outgrows while the
+     * pattern or a single jump needs more */
+    void SetMemory(size_t bytes);
+    size_t GetNodes() const;
+
+    /* seeds on the scheduler's threads, or on the calling thread without one */
+    void SetScheduler(Scheduler* scheduler);
+
+private:
+    /* a cube of 2^level cells, either a leaf of 4^3 cells (level 2) or eight children in x, y, z order */
+    struct Node
+    {
+        uint32_t children[8];
+        uint64_t bits;
+        uint64_t population;
+        /* the center after 2^min(level - 2, exponent) generations */
+        uint32_t result;
+        /* the next node in the bucket or the free list */
+        uint32_t next;
+        /* 0 when free */
+        uint8_t level;
+        bool marked;
+    };
+
+    uint32_t Allocate();
+    uint32_t Insert(uint32_t node, size_t hash);
+    uint32_t GetLeaf(uint64_t bits);
+    uint32_t GetNode(const uint32_t children[8]);
+    uint32_t GetEmpty(int level);
+    uint32_t GetCenter(uint32_t node);
+    uint32_t GetResult(uint32_t node);
+    uint64_t StepLeaves(uint32_t node, int generations) const;
+    uint32_t Expand(uint32_t node);
+    bool IsCentered(uint32_t node) const;
+    bool Jump(int exponent);
+    void SetExponent(int exponent);
+    void ClearResults(int level);
+    void Rehash(size_t size);
+    void Mark(uint32_t node, bool results);
+    void Collect();
+    int GetBoxLevel() const;
+    void Seed();
+    uint32_t Build(int level, int64_t x, int64_t y, int64_t z, const std::vector<uint64_t>& leaves);
+    void Extract(uint32_t node, int64_t x, int64_t y, int64_t z);
+
+    Rules rules;
+    uint64_t generation{0};
+    /* index 0 is never used, so it stands for none */
+    std::vector<Node> nodes = std::vector<Node>(1);
+    std::vector<uint32_t> buckets = std::vector<uint32_t>(1024);
+    uint32_t freeNodes{0};
+    size_t freeCount{0};
+    size_t capacity{HASH_MEMORY / (sizeof(Node) + sizeof(uint32_t))};
+    size_t limit{capacity};
+    /* whether the current jump collected garbage */
+    bool collected{false};
+    /* nodes being computed, which are kept through a collection along with the root and empty nodes */
+    std::vector<uint32_t> stack;
+    std::vector<uint32_t> empties;
+    /* centered on the origin, with the box in the positive octant */
+    uint32_t root{0};
+    /* the results are for jumps of 2^exponent generations */
+    int exponent{0};
+    std::vector<uint8_t> cells;
+    Scheduler* scheduler{nullptr};
+};
\ No newline at end of file
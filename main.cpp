@@ -8,27 +8,112 @@
 #include <imgui_impl_sdlgpu3.h>
 
 #include <algorithm>
+#include <cctype>
+#include <cfloat>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
+#include "bitengine.hpp"
 #include "config.hpp"
+#include "engine.hpp"
+#include "hashengine.hpp"
+#include "rules.hpp"
+#include "scheduler.hpp"
 #include "shader.hpp"
 
-static_assert(BOUNDS < 1024);
-static_assert(FRAMES == 2, "not implemented");
+static_assert(FRAMES >= 2, "the ring needs a slot to read and one to write");
 
 static SDL_Window* window;
 static SDL_GPUDevice* device;
 static SDL_GPUGraphicsPipeline* graphicsPipeline;
+static SDL_GPUGraphicsPipeline* nibbleGraphicsPipeline;
+static SDL_GPUGraphicsPipeline* bricksGraphicsPipeline;
 static SDL_GPUComputePipeline* computePipeline;
+static SDL_GPUComputePipeline* tiledPipeline;
+static SDL_GPUComputePipeline* packPipeline;
+static SDL_GPUComputePipeline* bitplanePipeline;
+static SDL_GPUComputePipeline* boxsumPipeline;
+static SDL_GPUComputePipeline* boxrulePipeline;
+static SDL_GPUComputePipeline* temporalPipeline;
+static SDL_GPUComputePipeline* activePipeline;
+static SDL_GPUComputePipeline* compactPipeline;
+static SDL_GPUComputePipeline* interiorPipeline;
+static SDL_GPUComputePipeline* borderPipeline;
+static SDL_GPUComputePipeline* prefixPipeline;
+static SDL_GPUComputePipeline* scanPipeline;
+static SDL_GPUComputePipeline* ltlPipeline;
+static SDL_GPUComputePipeline* batchPipeline;
+static SDL_GPUComputePipeline* seedPipeline;
+static SDL_GPUComputePipeline* seedBatchPipeline;
+static SDL_GPUComputePipeline* nibblePipeline;
+static SDL_GPUComputePipeline* nibblePackPipeline;
+static SDL_GPUComputePipeline* nibbleUnpackPipeline;
+static SDL_GPUComputePipeline* brickPipeline;
+static SDL_GPUComputePipeline* brickPackPipeline;
+static SDL_GPUComputePipeline* brickUnpackPipeline;
+static SDL_GPUComputePipeline* statsPipeline;
 static SDL_GPUTexture* textures[FRAMES];
+static SDL_GPUTexture* planes[FRAMES];
+static bool planesDirty{true};
+static SDL_GPUTexture* sums[2];
+static SDL_GPUTexture* prefix;
+/* how the ring stores cells, see GetLayout */
+static int layout{LAYOUT_BYTES};
+static bool packing{true};
+static bool bricking;
+static SDL_GPUBuffer* cellsBuffers[FRAMES];
 static int readFrame{0};
 static int writeFrame{1};
+static int history;
 static SDL_GPUBuffer* vertexBuffer;
-static SDL_GPUBuffer* instanceBuffer;
+static SDL_GPUBuffer* flagsBuffer;
+static SDL_GPUBuffer* bricksBuffer;
+/* the active kernel's indirect dispatch, followed by the number of bricks it covers */
+struct ActiveArgs
+{
+    SDL_GPUIndirectDispatchCommand dispatch;
+    uint32_t count;
+};
+static SDL_GPUBuffer* argsBuffer;
+static SDL_GPUTransferBuffer* argsTransferBuffer;
+/* generations left that need every brick simulated, the ring needs one per slot besides the one written */
+static int bricksDirty{FRAMES - 1};
+static SDL_GPUBuffer* statsBuffer;
+static SDL_GPUTransferBuffer* statsResetTransferBuffer;
+static SDL_GPUBuffer* transitionsBuffer;
+static SDL_GPUTransferBuffer* transitionsTransferBuffer;
+static bool transitionsDirty{true};
+/* a table that replaces entries of the preset, see LoadTransitions */
+static constexpr const char* transitionsPath = "transitions.txt";
+struct TransitionOverride
+{
+    uint32_t value;
+    uint32_t neighbors;
+    uint32_t next;
+};
+static std::vector<TransitionOverride> transitionOverrides;
+static bool customTransitions;
+static SDL_GPUTexture* batchTextures[FRAMES];
+static SDL_GPUBuffer* universesBuffer;
+static SDL_GPUBuffer* batchTransitionsBuffer;
+static bool universesDirty;
+static int universeTiles[3];
+static int universeSize;
+static int viewedUniverse;
+static int batchSettings[2]{0, UNIVERSE_SIZE};
+static bool batching;
 static SDL_GPUTexture* depthTexture;
 static int depthTextureWidth;
 static int depthTextureHeight;
@@ -40,17 +125,116 @@ static uint64_t time2;
 static float delta;
 static float delay{10.0f};
 static bool imguiFocused;
+static int kernel{KERNEL_DEFAULT};
+static bool subgroups;
+static int temporalSteps{TEMPORAL_STEPS};
+static int gridSize[3]{BOUNDS, BOUNDS, BOUNDS};
+static bool resizing;
 
-struct
+static Rules rules;
+static decltype(rules) activeRules;
+
+struct Universe
 {
-    uint32_t seed{0};
-    uint32_t surviveMask{16};
-    uint32_t birthMask{96};
-    uint32_t life{32};
-    uint32_t neighborhood{MOORE};
-    uint32_t frame{0};
-}
-static rules;
+    uint32_t seed;
+    uint32_t surviveMask;
+    uint32_t birthMask;
+    uint32_t life;
+};
+
+static std::vector<Universe> universes;
+
+/* workgroup shapes of the default kernel (see add_shader_shapes), the first is automata.comp itself */
+struct Shape
+{
+    int x;
+    int y;
+    int z;
+    int cells;
+};
+
+static constexpr Shape shapes[] =
+{
+    {THREADS, THREADS, THREADS, 1}, {16, 8, 4, 1}, {32, 4, 2, 1}, {64, 2, 1, 1},
+    {THREADS, THREADS, THREADS, 4}, {16, 8, 4, 4}, {32, 4, 2, 4}, {64, 2, 1, 4},
+};
+
+/* fastest shape per grid size and neighborhood on this device */
+static std::unordered_map<std::string, int> tunings;
+static bool autotune;
+
+/* seed volumes of the current grid size, keyed by the noise parameters and evicted least recently used first */
+struct SeedVolume
+{
+    uint32_t seed;
+    float frequency;
+    float threshold;
+    SDL_GPUTexture* texture;
+    uint64_t used;
+};
+
+/* an evicted volume on its way to the disk */
+struct SeedSpill
+{
+    std::string path;
+    SDL_GPUTransferBuffer* transferBuffer;
+    SDL_GPUFence* fence;
+    uint32_t size;
+};
+
+/* mirrors the buffer in stats.comp */
+struct Stats
+{
+    uint32_t alive;
+    uint32_t births;
+    uint32_t deaths;
+    uint32_t minimum[3];
+    uint32_t maximum[3];
+    uint32_t hash[2];
+    uint32_t states[MAX_LIFE + 1];
+};
+
+/* a download of the statistics, free while it has no fence */
+struct StatsReadback
+{
+    SDL_GPUTransferBuffer* transferBuffer;
+    SDL_GPUFence* fence;
+    uint32_t frame;
+    uint64_t clock;
+    uint64_t run;
+};
+
+/* a generation the detection can match later ones against */
+struct StatsHash
+{
+    uint32_t frame;
+    uint32_t alive;
+    uint32_t hash[2];
+};
+
+static StatsReadback statsReadbacks[STATS_READBACKS];
+static Stats stats;
+static uint32_t statsFrame;
+static uint64_t statsClock;
+static uint64_t statsRun;
+static bool statistics{true};
+static int policy{POLICY_REPORT};
+static std::deque<StatsHash> hashes;
+static uint64_t hashesRun;
+static uint64_t detectedRun{UINT64_MAX};
+static std::string detection;
+static bool paused;
+static Engine engine;
+static BitEngine bitEngine;
+static HashEngine hashEngine;
+static bool verifying;
+static std::string verification;
+
+static SeedVolume seedVolumes[SEED_CACHE];
+static uint64_t seedClock;
+static std::deque<uint32_t> nextSeeds;
+static std::vector<SeedSpill> seedSpills;
+static bool seedSpill;
 
 static bool Init()
 {
@@ -97,37 +281,27 @@ static bool Init()
 static bool CreatePipelines()
 {
     SDL_GPUShader* vertShader = LoadShader(device, "render.vert");
+    SDL_GPUShader* nibbleVertShader = LoadShader(device, "render_nibble.vert");
+    SDL_GPUShader* bricksVertShader = LoadShader(device, "render_bricks.vert");
     SDL_GPUShader* fragShader = LoadShader(device, "render.frag");
-    if (!vertShader || !fragShader)
+    if (!vertShader || !nibbleVertShader || !bricksVertShader || !fragShader)
     {
         SDL_Log("Failed to load shader(s)");
         return false;
     }
-    SDL_GPUVertexBufferDescription buffers[2] =
+    SDL_GPUVertexBufferDescription buffers[1] =
     {{
         .slot = 0,
         .pitch = sizeof(float) * 3,
         .input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX,
         .instance_step_rate = 0,
-    },
-    {
-        .slot = 1,
-        .pitch = sizeof(uint32_t),
-        .input_rate = SDL_GPU_VERTEXINPUTRATE_INSTANCE,
-        .instance_step_rate = 0,
     }};
-    SDL_GPUVertexAttribute attribs[2] =
+    SDL_GPUVertexAttribute attribs[1] =
     {{
         .location = 0,
         .buffer_slot = 0,
         .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3,
         .offset = 0,
-    },
-    {
-        .location = 1,
-        .buffer_slot = 1,
-        .format = SDL_GPU_VERTEXELEMENTFORMAT_UINT,
-        .offset = 0,
     }};
     SDL_GPUColorTargetDescription targets[1] =
     {{
@@ -137,9 +311,9 @@ static bool CreatePipelines()
     info.vertex_shader = vertShader;
     info.fragment_shader = fragShader;
     info.vertex_input_state.vertex_buffer_descriptions = buffers;
-    info.vertex_input_state.num_vertex_buffers = 2;
+    info.vertex_input_state.num_vertex_buffers = 1;
     info.vertex_input_state.vertex_attributes = attribs;
-    info.vertex_input_state.num_vertex_attributes = 2;
+    info.vertex_input_state.num_vertex_attributes = 1;
     info.target_info.color_target_descriptions = targets;
     info.target_info.num_color_targets = 1;
     info.target_info.depth_stencil_format = SDL_GPU_TEXTUREFORMAT_D32_FLOAT;
@@ -148,403 +322,2762 @@ static bool CreatePipelines()
     info.depth_stencil_state.enable_depth_test = true;
     info.depth_stencil_state.enable_depth_write = true;
     graphicsPipeline = SDL_CreateGPUGraphicsPipeline(device, &info);
+    info.vertex_shader = nibbleVertShader;
+    nibbleGraphicsPipeline = SDL_CreateGPUGraphicsPipeline(device, &info);
+    info.vertex_shader = bricksVertShader;
+    bricksGraphicsPipeline = SDL_CreateGPUGraphicsPipeline(device, &info);
     computePipeline = LoadComputePipeline(device, "automata.comp");
-    if (!graphicsPipeline || !computePipeline)
+    tiledPipeline = LoadComputePipeline(device, "tiled.comp");
+    packPipeline = LoadComputePipeline(device, "pack.comp");
+    bitplanePipeline = LoadComputePipeline(device, "bitplane.comp");
+    boxsumPipeline = LoadComputePipeline(device, "boxsum.comp");
+    boxrulePipeline = LoadComputePipeline(device, "boxrule.comp");
+    temporalPipeline = LoadComputePipeline(device, "temporal.comp");
+    activePipeline = LoadComputePipeline(device, "active.comp");
+    compactPipeline = LoadComputePipeline(device, "compact.comp");
+    interiorPipeline = LoadComputePipeline(device, "interior.comp");
+    borderPipeline = LoadComputePipeline(device, "border.comp");
+    prefixPipeline = LoadComputePipeline(device, "prefix.comp");
+    scanPipeline = LoadComputePipeline(device, "scan.comp");
+    ltlPipeline = LoadComputePipeline(device, "ltl.comp");
+    batchPipeline = LoadComputePipeline(device, "batch.comp");
+    seedPipeline = LoadComputePipeline(device, "seed.comp");
+    seedBatchPipeline = LoadComputePipeline(device, "seed_batch.comp");
+    nibblePipeline = LoadComputePipeline(device, "nibble.comp");
+    nibblePackPipeline = LoadComputePipeline(device, "nibblepack.comp");
+    nibbleUnpackPipeline = LoadComputePipeline(device, "nibbleunpack.comp");
+    brickPipeline = LoadComputePipeline(device, "brick.comp");
+    brickPackPipeline = LoadComputePipeline(device, "brickpack.comp");
+    brickUnpackPipeline = LoadComputePipeline(device, "brickunpack.comp");
+    statsPipeline = LoadComputePipeline(device, "stats.comp");
+    if (!graphicsPipeline || !nibbleGraphicsPipeline || !bricksGraphicsPipeline || !computePipeline || !tiledPipeline || !packPipeline || !bitplanePipeline ||
+        !boxsumPipeline || !boxrulePipeline || !temporalPipeline || !activePipeline || !compactPipeline ||
+        !interiorPipeline || !borderPipeline || !prefixPipeline || !scanPipeline || !ltlPipeline ||
+        !batchPipeline || !seedPipeline || !seedBatchPipeline || !nibblePipeline || !nibblePackPipeline ||
+        !nibbleUnpackPipeline || !brickPipeline || !brickPackPipeline || !brickUnpackPipeline ||
+        !statsPipeline)
     {
         SDL_Log("Failed to create pipeline(s): %s", SDL_GetError());
         return false;
     }
     SDL_ReleaseGPUShader(device, vertShader);
+    SDL_ReleaseGPUShader(device, nibbleVertShader);
+    SDL_ReleaseGPUShader(device, bricksVertShader);
     SDL_ReleaseGPUShader(device, fragShader);
     return true;
 }
 
-static bool CreateResources()
+static int GetGroups(int size)
 {
-    SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
-    if (!commandBuffer)
+    return (size + THREADS - 1) / THREADS;
+}
+
+static int GetWords()
+{
+    return (rules.width + 31) / 32;
+}
+
+static int GetNibbles()
+{
+    return (rules.width + 7) / 8;
+}
+
+static int GetCellBricks(int size)
+{
+    return (size + BRICK - 1) / BRICK;
+}
+
+/* bytes per frame in the bricks layout, including the padding of the last bricks */
+static uint32_t GetCellsSize()
+{
+    return GetCellBricks(rules.width) * GetCellBricks(rules.height) * GetCellBricks(rules.depth) * BRICK * BRICK * BRICK;
+}
+
+static int GetBrickCount()
+{
+    return GetGroups(rules.width) * GetGroups(rules.height) * GetGroups(rules.depth);
+}
+
+static SDL_GPUTexture* CreateVolume(SDL_GPUTextureFormat format, SDL_GPUTextureUsageFlags usage, int width, int height, int depth)
+{
+    SDL_GPUTextureCreateInfo info{};
+    info.type = SDL_GPU_TEXTURETYPE_3D;
+    info.format = format;
+    info.usage = usage;
+    info.width = width;
+    info.height = height;
+    info.layer_count_or_depth = depth;
+    info.num_levels = 1;
+    SDL_GPUTexture* texture = SDL_CreateGPUTexture(device, &info);
+    if (!texture)
     {
-        SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
-        return false;
+        SDL_Log("Failed to create texture: %s", SDL_GetError());
     }
-    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
-    if (!copyPass)
+    return texture;
+}
+
+static void ReleaseSeedVolumes()
+{
+    for (SeedVolume& volume : seedVolumes)
     {
-        SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
-        return false;
+        SDL_ReleaseGPUTexture(device, volume.texture);
+        volume = SeedVolume{};
     }
+}
+
+static void ReleaseGrid()
+{
+    /* cached seeds are only valid for the grid size they were made with */
+    ReleaseSeedVolumes();
     for (int i = 0; i < FRAMES; i++)
     {
-        SDL_GPUTextureCreateInfo info{};
-        info.type = SDL_GPU_TEXTURETYPE_3D;
-        info.format = SDL_GPU_TEXTUREFORMAT_R8_UINT;
-        info.usage =
-            SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ |
-            SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE |
-            SDL_GPU_TEXTUREUSAGE_GRAPHICS_STORAGE_READ;
-        info.width = BOUNDS;
-        info.height = BOUNDS;
-        info.layer_count_or_depth = BOUNDS;
-        info.num_levels = 1;
-        textures[i] = SDL_CreateGPUTexture(device, &info);
+        SDL_ReleaseGPUTexture(device, textures[i]);
+        SDL_ReleaseGPUTexture(device, planes[i]);
+        SDL_ReleaseGPUBuffer(device, cellsBuffers[i]);
+        textures[i] = nullptr;
+        planes[i] = nullptr;
+        cellsBuffers[i] = nullptr;
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        SDL_ReleaseGPUTexture(device, sums[i]);
+        sums[i] = nullptr;
+    }
+    SDL_ReleaseGPUTexture(device, prefix);
+    prefix = nullptr;
+    SDL_ReleaseGPUBuffer(device, flagsBuffer);
+    SDL_ReleaseGPUBuffer(device, bricksBuffer);
+    flagsBuffer = nullptr;
+    bricksBuffer = nullptr;
+}
+
+/* everything sized by the grid, recreated whenever it's resized */
+static bool CreateGrid()
+{
+    int width = rules.width;
+    int height = rules.height;
+    int depth = rules.depth;
+    SDL_GPUTextureUsageFlags usage =
+        SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ |
+        SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE;
+    /* the nibbles and bricks layouts have their own kernels and skip the byte kernels' textures */
+    for (int i = 0; layout == LAYOUT_NIBBLES && i < FRAMES; i++)
+    {
+        textures[i] = CreateVolume(SDL_GPU_TEXTUREFORMAT_R32_UINT, usage | SDL_GPU_TEXTUREUSAGE_GRAPHICS_STORAGE_READ, GetNibbles(), height, depth);
         if (!textures[i])
         {
-            SDL_Log("Failed to create texture: %s", SDL_GetError());
             return false;
         }
     }
+    for (int i = 0; layout == LAYOUT_BYTES && i < FRAMES; i++)
     {
-        float vertices[36 * 3] =
-        {
-           -0.5f,-0.5f, 0.5f,
-            0.5f,-0.5f, 0.5f,
-            0.5f, 0.5f, 0.5f,
-           -0.5f,-0.5f, 0.5f,
-            0.5f, 0.5f, 0.5f,
-           -0.5f, 0.5f, 0.5f,
-           -0.5f,-0.5f,-0.5f,
-            0.5f, 0.5f,-0.5f,
-            0.5f,-0.5f,-0.5f,
-           -0.5f,-0.5f,-0.5f,
-           -0.5f, 0.5f,-0.5f,
-            0.5f, 0.5f,-0.5f,
-           -0.5f,-0.5f,-0.5f,
-           -0.5f,-0.5f, 0.5f,
-           -0.5f, 0.5f, 0.5f,
-           -0.5f,-0.5f,-0.5f,
-           -0.5f, 0.5f, 0.5f,
-           -0.5f, 0.5f,-0.5f,
-            0.5f,-0.5f,-0.5f,
-            0.5f, 0.5f, 0.5f,
-            0.5f,-0.5f, 0.5f,
-            0.5f,-0.5f,-0.5f,
-            0.5f, 0.5f,-0.5f,
-            0.5f, 0.5f, 0.5f,
-           -0.5f, 0.5f,-0.5f,
-           -0.5f, 0.5f, 0.5f,
-            0.5f, 0.5f, 0.5f,
-           -0.5f, 0.5f,-0.5f,
-            0.5f, 0.5f, 0.5f,
-            0.5f, 0.5f,-0.5f,
-           -0.5f,-0.5f,-0.5f,
-            0.5f,-0.5f, 0.5f,
-           -0.5f,-0.5f, 0.5f,
-           -0.5f,-0.5f,-0.5f,
-            0.5f,-0.5f,-0.5f,
-            0.5f,-0.5f, 0.5f,
-        };
-        SDL_GPUTransferBuffer* transferBuffer;
-        {
-            SDL_GPUTransferBufferCreateInfo info{};
-            info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-            info.size = sizeof(vertices);
-            transferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
-            if (!transferBuffer)
-            {
-                SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
-                return false;
-            }
-        }
-        void* data = SDL_MapGPUTransferBuffer(device, transferBuffer, false);
-        if (!data)
+        textures[i] = CreateVolume(SDL_GPU_TEXTUREFORMAT_R8_UINT, usage | SDL_GPU_TEXTUREUSAGE_GRAPHICS_STORAGE_READ, width, height, depth);
+        planes[i] = CreateVolume(SDL_GPU_TEXTUREFORMAT_R32_UINT, usage, GetWords(), height, depth);
+        if (!textures[i] || !planes[i])
         {
-            SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
             return false;
         }
-        {
-            SDL_GPUBufferCreateInfo info{};
-            info.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
-            info.size = sizeof(vertices);
-            vertexBuffer = SDL_CreateGPUBuffer(device, &info);
-            if (!vertexBuffer)
-            {
-                SDL_Log("Failed to create buffer: %s", SDL_GetError());
-                return false;
-            }
-        }
-        std::memcpy(data, vertices, sizeof(vertices));
-        SDL_GPUTransferBufferLocation location{};
-        SDL_GPUBufferRegion region{};
-        location.transfer_buffer = transferBuffer;
-        region.buffer = vertexBuffer;
-        region.size = sizeof(vertices);
-        SDL_UploadToGPUBuffer(copyPass, &location, &region, false);
-        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
     }
+    for (int i = 0; layout == LAYOUT_BYTES && i < 2; i++)
     {
-        SDL_GPUTransferBuffer* transferBuffer;
-        {
-            SDL_GPUTransferBufferCreateInfo info{};
-            info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-            info.size = BOUNDS * BOUNDS * BOUNDS * sizeof(uint32_t);
-            transferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
-            if (!transferBuffer)
-            {
-                SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
-                return 1;
-            }
-        }
-        uint32_t* data = static_cast<uint32_t*>(SDL_MapGPUTransferBuffer(device, transferBuffer, false));
-        if (!data)
+        sums[i] = CreateVolume(SDL_GPU_TEXTUREFORMAT_R8_UINT, usage, width, height, depth);
+        if (!sums[i])
         {
-            SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
             return false;
         }
+    }
+    SDL_GPUBufferCreateInfo info{};
+    for (int i = 0; layout == LAYOUT_BRICKS && i < FRAMES; i++)
+    {
+        info.usage =
+            SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ |
+            SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE |
+            SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
+        info.size = GetCellsSize();
+        cellsBuffers[i] = SDL_CreateGPUBuffer(device, &info);
+        if (!cellsBuffers[i])
         {
-            SDL_GPUBufferCreateInfo info{};
-            info.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
-            info.size = BOUNDS * BOUNDS * BOUNDS * sizeof(uint32_t);
-            instanceBuffer = SDL_CreateGPUBuffer(device, &info);
-            if (!instanceBuffer)
-            {
-                SDL_Log("Failed to create buffer: %s", SDL_GetError());
-                return false;
-            }
-        }
-        uint32_t i = 0;
-        for (int x = 0; x < BOUNDS; x++)
-        for (int y = 0; y < BOUNDS; y++)
-        for (int z = 0; z < BOUNDS; z++)
-        {
-            data[i] = 0;
-            data[i] |= x << 0;
-            data[i] |= y << 10;
-            data[i] |= z << 20;
-            i++;
+            SDL_Log("Failed to create buffer: %s", SDL_GetError());
+            return false;
         }
-        SDL_GPUTransferBufferLocation location{};
-        SDL_GPUBufferRegion region{};
-        location.transfer_buffer = transferBuffer;
-        region.buffer = instanceBuffer;
-        region.size = BOUNDS * BOUNDS * BOUNDS * sizeof(uint32_t);
-        SDL_UploadToGPUBuffer(copyPass, &location, &region, false);
-        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
     }
-    SDL_EndGPUCopyPass(copyPass);
-    SDL_SubmitGPUCommandBuffer(commandBuffer);
+    info.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+    info.size = FRAMES * GetBrickCount() * sizeof(uint32_t);
+    flagsBuffer = SDL_CreateGPUBuffer(device, &info);
+    info.size = GetBrickCount() * sizeof(uint32_t);
+    bricksBuffer = SDL_CreateGPUBuffer(device, &info);
+    if (!flagsBuffer || !bricksBuffer)
+    {
+        SDL_Log("Failed to create buffer: %s", SDL_GetError());
+        return false;
+    }
+    rules.frame = 0;
+    planesDirty = true;
+    bricksDirty = FRAMES - 1;
     return true;
 }
 
-static void DrawImGui()
+static bool Resize(int width, int height, int depth)
 {
-    ImGui_ImplSDLGPU3_NewFrame();
-    ImGui::NewFrame();
-    ImGui::Begin("Settings");
-    imguiFocused = ImGui::IsWindowFocused();
-    if (ImGui::Button("Reset"))
+    uint32_t oldWidth = rules.width;
+    uint32_t oldHeight = rules.height;
+    uint32_t oldDepth = rules.depth;
+    SDL_WaitForGPUIdle(device);
+    ReleaseGrid();
+    rules.width = width;
+    rules.height = height;
+    rules.depth = depth;
+    if (CreateGrid())
     {
-        rules.seed = std::rand() % RAND_MAX;
-        rules.frame = 0;
+        return true;
     }
-    ImGui::SliderFloat("Speed", &delay, 0.0f, 1000.0f);
-    ImGui::Text("Survive");
-    for (int i = 1; i < 27; i++)
+    SDL_Log("Failed to resize grid to %dx%dx%d", width, height, depth);
+    ReleaseGrid();
+    rules.width = oldWidth;
+    rules.height = oldHeight;
+    rules.depth = oldDepth;
+    return CreateGrid();
+}
+
+/* larger than life kernels only read bytes, and life has to fit in a nibble */
+static int GetLayout()
+{
+    if (rules.neighborhood != MOORE && rules.neighborhood != VON_NEUMANN)
     {
-        bool bit = (rules.surviveMask >> i) & 1;
-        if (i % 7 == 0)
-        {
-            ImGui::NewLine();
-        }
-        ImGui::PushID(i);
-        if (ImGui::Checkbox("", &bit))
-        {
-            if (bit)
-            {
-                rules.surviveMask |= (1 << i);
-            }
-            else
-            {
-                rules.surviveMask &= ~(1 << i);
-            }
-        }
-        ImGui::SameLine();
-        ImGui::Text("%02d", i);
-        ImGui::SameLine();
-        ImGui::PopID();
+        return LAYOUT_BYTES;
     }
-    ImGui::NewLine();
-    ImGui::Text("Birth");
-    for (int i = 1; i < 27; i++)
+    if (bricking)
     {
-        bool bit = (rules.birthMask >> i) & 1;
-        if (i % 7 == 0)
-        {
-            ImGui::NewLine();
-        }
-        ImGui::PushID(32 + i);
-        if (ImGui::Checkbox("", &bit))
-        {
-            if (bit)
-            {
-                rules.birthMask |= (1 << i);
-            }
-            else
-            {
-                rules.birthMask &= ~(1 << i);
-            }
-        }
-        ImGui::SameLine();
-        ImGui::Text("%02d", i);
-        ImGui::SameLine();
-        ImGui::PopID();
+        return LAYOUT_BRICKS;
     }
-    ImGui::NewLine();
-    int life = rules.life;
-    int neighborhood = rules.neighborhood;
-    ImGui::SliderInt("Life", &life, 1, 64);
-    ImGui::Text("Neighborhood");
-    ImGui::RadioButton("Moore", &neighborhood, 0);
-    ImGui::RadioButton("Von Neumann", &neighborhood, 1);
-    rules.life = life;
-    rules.neighborhood = neighborhood;
-    ImGui::End();
-    ImGui::Render();
+    if (packing && rules.life <= 15)
+    {
+        return LAYOUT_NIBBLES;
+    }
+    return LAYOUT_BYTES;
 }
 
-static void Draw()
+/* writes a volume of bytes into a frame of the ring in the grid's layout */
+static void PackBytes(SDL_GPUCommandBuffer* commandBuffer, SDL_GPUTexture* bytes, int frame)
 {
-    SDL_WaitForGPUSwapchain(device, window);
-    SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
-    if (!commandBuffer)
+    if (layout == LAYOUT_BYTES)
     {
-        SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
-        return;
+        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+        if (!copyPass)
+        {
+            SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+            return;
+        }
+        SDL_GPUTextureLocation source{};
+        SDL_GPUTextureLocation destination{};
+        source.texture = bytes;
+        destination.texture = textures[frame];
+        SDL_CopyGPUTextureToTexture(copyPass, &source, &destination, rules.width, rules.height, rules.depth, false);
+        SDL_EndGPUCopyPass(copyPass);
+        return;
     }
-    SDL_GPUTexture* texture;
-    uint32_t width;
-    uint32_t height;
-    if (!SDL_AcquireGPUSwapchainTexture(commandBuffer, window, &texture, &width, &height))
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    SDL_GPUStorageBufferReadWriteBinding bufferBinding{};
+    SDL_GPUComputePass* computePass;
+    if (layout == LAYOUT_NIBBLES)
     {
-        SDL_Log("Failed to acquire swapchain texture: %s", SDL_GetError());
+        textureBinding.texture = textures[frame];
+        computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    }
+    else
+    {
+        bufferBinding.buffer = cellsBuffers[frame];
+        computePass = SDL_BeginGPUComputePass(commandBuffer, nullptr, 0, &bufferBinding, 1);
+    }
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_BindGPUComputeStorageTextures(computePass, 0, &bytes, 1);
+    if (layout == LAYOUT_NIBBLES)
+    {
+        SDL_BindGPUComputePipeline(computePass, nibblePackPipeline);
+        SDL_DispatchGPUCompute(computePass, GetGroups(GetNibbles()), GetGroups(rules.height), GetGroups(rules.depth));
+    }
+    else
+    {
+        SDL_BindGPUComputePipeline(computePass, brickPackPipeline);
+        SDL_DispatchGPUCompute(computePass, GetCellBricks(rules.width), GetCellBricks(rules.height), GetCellBricks(rules.depth));
+    }
+    SDL_EndGPUComputePass(computePass);
+}
+
+/* reads a frame stored in another layout back into a volume of bytes */
+static void UnpackBytes(SDL_GPUCommandBuffer* commandBuffer, int frameLayout, SDL_GPUTexture* texture,
+    SDL_GPUBuffer* buffer, SDL_GPUTexture* bytes)
+{
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = bytes;
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    if (frameLayout == LAYOUT_NIBBLES)
+    {
+        SDL_BindGPUComputePipeline(computePass, nibbleUnpackPipeline);
+        SDL_BindGPUComputeStorageTextures(computePass, 0, &texture, 1);
+    }
+    else
+    {
+        SDL_BindGPUComputePipeline(computePass, brickUnpackPipeline);
+        SDL_BindGPUComputeStorageBuffers(computePass, 0, &buffer, 1);
+    }
+    SDL_DispatchGPUCompute(computePass, GetGroups(rules.width), GetGroups(rules.height), GetGroups(rules.depth));
+    SDL_EndGPUComputePass(computePass);
+}
+
+/* copies a frame to the rest of the ring */
+static void FillRing(SDL_GPUCommandBuffer* commandBuffer, int frame)
+{
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    if (!copyPass)
+    {
+        SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+        return;
+    }
+    int width = layout == LAYOUT_NIBBLES ? GetNibbles() : rules.width;
+    for (int i = 0; i < FRAMES; i++)
+    {
+        if (i == frame)
+        {
+            continue;
+        }
+        if (layout == LAYOUT_BRICKS)
+        {
+            SDL_GPUBufferLocation source{};
+            SDL_GPUBufferLocation destination{};
+            source.buffer = cellsBuffers[frame];
+            destination.buffer = cellsBuffers[i];
+            SDL_CopyGPUBufferToBuffer(copyPass, &source, &destination, GetCellsSize(), false);
+            continue;
+        }
+        SDL_GPUTextureLocation source{};
+        SDL_GPUTextureLocation destination{};
+        source.texture = textures[frame];
+        destination.texture = textures[i];
+        SDL_CopyGPUTextureToTexture(copyPass, &source, &destination, width, rules.height, rules.depth, false);
+    }
+    SDL_EndGPUCopyPass(copyPass);
+}
+
+/* converts the newest generation to another layout (through bytes) and fills the ring with it,
+ * keeping the old layout when that fails and returning false only if even that can't be recreated */
+static bool Relayout(int newLayout)
+{
+    static const char* names[] = {"bytes", "nibbles", "bricks"};
+    uint32_t frame = rules.frame;
+    SDL_WaitForGPUIdle(device);
+    SDL_GPUTexture* oldTexture = textures[readFrame];
+    SDL_GPUBuffer* oldBuffer = cellsBuffers[readFrame];
+    int oldLayout = layout;
+    textures[readFrame] = nullptr;
+    cellsBuffers[readFrame] = nullptr;
+    ReleaseGrid();
+    layout = newLayout;
+    bool created = CreateGrid();
+    if (!created)
+    {
+        SDL_Log("Failed to create %s grid", names[newLayout]);
+    }
+    else if (frame > 0)
+    {
+        SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
+        if (!commandBuffer)
+        {
+            SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
+            created = false;
+        }
+        else
+        {
+            SDL_GPUTexture* bytes = oldTexture;
+            if (oldLayout != LAYOUT_BYTES)
+            {
+                SDL_GPUTextureUsageFlags usage =
+                    SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ |
+                    SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE;
+                bytes = CreateVolume(SDL_GPU_TEXTUREFORMAT_R8_UINT, usage, rules.width, rules.height, rules.depth);
+            }
+            if (bytes)
+            {
+                if (oldLayout != LAYOUT_BYTES)
+                {
+                    UnpackBytes(commandBuffer, oldLayout, oldTexture, oldBuffer, bytes);
+                }
+                PackBytes(commandBuffer, bytes, readFrame);
+                FillRing(commandBuffer, readFrame);
+                rules.frame = frame;
+            }
+            else
+            {
+                created = false;
+            }
+            SDL_SubmitGPUCommandBuffer(commandBuffer);
+            if (bytes && bytes != oldTexture)
+            {
+                SDL_ReleaseGPUTexture(device, bytes);
+            }
+        }
+    }
+    if (created)
+    {
+        SDL_ReleaseGPUTexture(device, oldTexture);
+        SDL_ReleaseGPUBuffer(device, oldBuffer);
+        return true;
+    }
+    /* puts the old generation back, like Resize keeps the old size */
+    SDL_WaitForGPUIdle(device);
+    ReleaseGrid();
+    layout = oldLayout;
+    if (!CreateGrid())
+    {
+        SDL_Log("Failed to recreate %s grid", names[oldLayout]);
+        SDL_ReleaseGPUTexture(device, oldTexture);
+        SDL_ReleaseGPUBuffer(device, oldBuffer);
+        return false;
+    }
+    SDL_ReleaseGPUTexture(device, textures[readFrame]);
+    SDL_ReleaseGPUBuffer(device, cellsBuffers[readFrame]);
+    textures[readFrame] = oldTexture;
+    cellsBuffers[readFrame] = oldBuffer;
+    if (frame > 0)
+    {
+        SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
+        if (!commandBuffer)
+        {
+            SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
+            return true;
+        }
+        FillRing(commandBuffer, readFrame);
+        SDL_SubmitGPUCommandBuffer(commandBuffer);
+        rules.frame = frame;
+    }
+    return true;
+}
+
+static void RandomizeUniverses()
+{
+    /* the first universe keeps the current rules to compare the others against */
+    for (size_t i = 0; i < universes.size(); i++)
+    {
+        Universe& universe = universes[i];
+        universe.seed = std::rand() % RAND_MAX;
+        universe.surviveMask = rules.surviveMask;
+        universe.birthMask = rules.birthMask;
+        universe.life = rules.life;
+        if (i > 0)
+        {
+            universe.surviveMask = (std::rand() ^ (std::rand() << 15)) & 0x7FFFFFE;
+            universe.birthMask = (std::rand() ^ (std::rand() << 15)) & 0x7FFFFFE;
+        }
+    }
+    universesDirty = true;
+    rules.frame = 0;
+}
+
+/* the first universe follows the current rules as they're edited, the others keep theirs until reshuffled */
+static void RefreshFirstUniverse()
+{
+    if (universes.empty())
+    {
+        return;
+    }
+    universes[0].surviveMask = rules.surviveMask;
+    universes[0].birthMask = rules.birthMask;
+    universes[0].life = rules.life;
+    universesDirty = true;
+}
+
+static void ReleaseBatch()
+{
+    for (int i = 0; i < FRAMES; i++)
+    {
+        SDL_ReleaseGPUTexture(device, batchTextures[i]);
+        batchTextures[i] = nullptr;
+    }
+    SDL_ReleaseGPUBuffer(device, universesBuffer);
+    SDL_ReleaseGPUBuffer(device, batchTransitionsBuffer);
+    universesBuffer = nullptr;
+    batchTransitionsBuffer = nullptr;
+    universes.clear();
+}
+
+static bool CreateBatch(int count, int size)
+{
+    SDL_WaitForGPUIdle(device);
+    ReleaseBatch();
+    /* leaving or entering the batch reseeds everything */
+    rules.frame = 0;
+    if (count <= 0)
+    {
+        return true;
+    }
+    /* tile the universes as close to a cube as possible */
+    universeTiles[0] = std::ceil(std::cbrt(float(count)));
+    universeTiles[1] = std::ceil(std::sqrt(float(count) / universeTiles[0]));
+    universeTiles[2] = (count + universeTiles[0] * universeTiles[1] - 1) / (universeTiles[0] * universeTiles[1]);
+    universeSize = size;
+    SDL_GPUTextureUsageFlags usage =
+        SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ |
+        SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE |
+        SDL_GPU_TEXTUREUSAGE_GRAPHICS_STORAGE_READ;
+    for (int i = 0; i < FRAMES; i++)
+    {
+        batchTextures[i] = CreateVolume(SDL_GPU_TEXTUREFORMAT_R8_UINT, usage,
+            universeTiles[0] * size, universeTiles[1] * size, universeTiles[2] * size);
+        if (!batchTextures[i])
+        {
+            ReleaseBatch();
+            return false;
+        }
+    }
+    SDL_GPUBufferCreateInfo info{};
+    info.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ;
+    info.size = count * sizeof(Universe);
+    universesBuffer = SDL_CreateGPUBuffer(device, &info);
+    info.size = count * sizeof(uint32_t) * (MAX_LIFE + 1) * COUNTS;
+    batchTransitionsBuffer = SDL_CreateGPUBuffer(device, &info);
+    if (!universesBuffer || !batchTransitionsBuffer)
+    {
+        SDL_Log("Failed to create buffer: %s", SDL_GetError());
+        ReleaseBatch();
+        return false;
+    }
+    universes.resize(count);
+    viewedUniverse = std::min(viewedUniverse, count - 1);
+    RandomizeUniverses();
+    return true;
+}
+
+/* larger than life isn't batched, those neighborhoods keep running on the single grid */
+static bool IsBatching()
+{
+    return !universes.empty() && rules.neighborhood != BOX && rules.neighborhood != DIAMOND;
+}
+
+static uint32_t NextSeed()
+{
+    if (nextSeeds.empty())
+    {
+        nextSeeds.push_back(std::rand() % RAND_MAX);
+    }
+    uint32_t seed = nextSeeds.front();
+    nextSeeds.pop_front();
+    return seed;
+}
+
+static int GetSeedCapacity()
+{
+    uint64_t size = uint64_t(rules.width) * rules.height * rules.depth;
+    return std::clamp<uint64_t>(SEED_CACHE_SIZE / size, 1, SEED_CACHE);
+}
+
+static SeedVolume* FindSeedVolume(uint32_t seed)
+{
+    for (SeedVolume& volume : seedVolumes)
+    {
+        if (volume.texture && volume.seed == seed && volume.frequency == rules.frequency &&
+            volume.threshold == rules.threshold)
+        {
+            return &volume;
+        }
+    }
+    return nullptr;
+}
+
+static std::string GetSeedPath(const SeedVolume& volume)
+{
+    return std::format("seed_{}_{}_{}_{}x{}x{}.bin", volume.seed, volume.frequency,
+        volume.threshold, rules.width, rules.height, rules.depth);
+}
+
+static void SpillSeedVolume(const SeedVolume& volume)
+{
+    uint32_t size = rules.width * rules.height * rules.depth;
+    SeedSpill spill{};
+    spill.path = GetSeedPath(volume);
+    spill.size = size;
+    SDL_GPUTransferBufferCreateInfo info{};
+    info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+    info.size = size;
+    spill.transferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
+    if (!spill.transferBuffer)
+    {
+        SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
+        return;
+    }
+    /* submitted on its own so the download is ordered before the volume is reused */
+    SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
+    if (!commandBuffer)
+    {
+        SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, spill.transferBuffer);
+        return;
+    }
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    if (!copyPass)
+    {
+        SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
         SDL_CancelGPUCommandBuffer(commandBuffer);
+        SDL_ReleaseGPUTransferBuffer(device, spill.transferBuffer);
+        return;
+    }
+    SDL_GPUTextureRegion region{};
+    SDL_GPUTextureTransferInfo transferInfo{};
+    region.texture = volume.texture;
+    region.w = rules.width;
+    region.h = rules.height;
+    region.d = rules.depth;
+    transferInfo.transfer_buffer = spill.transferBuffer;
+    SDL_DownloadFromGPUTexture(copyPass, &region, &transferInfo);
+    SDL_EndGPUCopyPass(copyPass);
+    spill.fence = SDL_SubmitGPUCommandBufferAndAcquireFence(commandBuffer);
+    if (!spill.fence)
+    {
+        SDL_Log("Failed to submit command buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, spill.transferBuffer);
+        return;
+    }
+    seedSpills.push_back(spill);
+}
+
+/* writes finished downloads to disk */
+static void PollSeedSpills()
+{
+    for (auto it = seedSpills.begin(); it != seedSpills.end();)
+    {
+        if (!SDL_QueryGPUFence(device, it->fence))
+        {
+            it++;
+            continue;
+        }
+        const char* data = static_cast<const char*>(SDL_MapGPUTransferBuffer(device, it->transferBuffer, false));
+        if (data)
+        {
+            std::ofstream file(it->path, std::ios::binary);
+            file.write(data, it->size);
+            if (file.fail())
+            {
+                SDL_Log("Failed to write seed: %s", it->path.data());
+            }
+            SDL_UnmapGPUTransferBuffer(device, it->transferBuffer);
+        }
+        else
+        {
+            SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
+        }
+        SDL_ReleaseGPUFence(device, it->fence);
+        SDL_ReleaseGPUTransferBuffer(device, it->transferBuffer);
+        it = seedSpills.erase(it);
+    }
+}
+
+static bool LoadSeedVolume(SDL_GPUCommandBuffer* commandBuffer, const SeedVolume& volume)
+{
+    std::string path = GetSeedPath(volume);
+    std::ifstream file(path, std::ios::binary);
+    if (file.fail())
+    {
+        return false;
+    }
+    uint32_t size = rules.width * rules.height * rules.depth;
+    std::string data(std::istreambuf_iterator<char>(file), {});
+    if (data.size() != size)
+    {
+        SDL_Log("Bad seed size: %s", path.data());
+        return false;
+    }
+    SDL_GPUTransferBufferCreateInfo info{};
+    info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+    info.size = size;
+    SDL_GPUTransferBuffer* transferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
+    if (!transferBuffer)
+    {
+        SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
+        return false;
+    }
+    void* mapped = SDL_MapGPUTransferBuffer(device, transferBuffer, false);
+    if (!mapped)
+    {
+        SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return false;
+    }
+    std::memcpy(mapped, data.data(), size);
+    SDL_UnmapGPUTransferBuffer(device, transferBuffer);
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    if (!copyPass)
+    {
+        SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return false;
+    }
+    SDL_GPUTextureTransferInfo transferInfo{};
+    SDL_GPUTextureRegion region{};
+    transferInfo.transfer_buffer = transferBuffer;
+    region.texture = volume.texture;
+    region.w = rules.width;
+    region.h = rules.height;
+    region.d = rules.depth;
+    SDL_UploadToGPUTexture(copyPass, &transferInfo, &region, false);
+    SDL_EndGPUCopyPass(copyPass);
+    SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+    return true;
+}
+
+/* returns the volume for the seed, generating (or loading) it on a miss */
+static SDL_GPUTexture* GetSeedVolume(SDL_GPUCommandBuffer* commandBuffer, uint32_t seed)
+{
+    seedClock++;
+    SeedVolume* volume = FindSeedVolume(seed);
+    if (volume)
+    {
+        volume->used = seedClock;
+        return volume->texture;
+    }
+    volume = &seedVolumes[0];
+    for (int i = 0; i < GetSeedCapacity(); i++)
+    {
+        if (!seedVolumes[i].texture)
+        {
+            volume = &seedVolumes[i];
+            break;
+        }
+        if (seedVolumes[i].used < volume->used)
+        {
+            volume = &seedVolumes[i];
+        }
+    }
+    if (!volume->texture)
+    {
+        /* read when PackBytes packs it into nibbles or bricks */
+        volume->texture = CreateVolume(SDL_GPU_TEXTUREFORMAT_R8_UINT,
+            SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ | SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE,
+            rules.width, rules.height, rules.depth);
+        if (!volume->texture)
+        {
+            return nullptr;
+        }
+    }
+    else if (seedSpill && !std::filesystem::exists(GetSeedPath(*volume)))
+    {
+        SpillSeedVolume(*volume);
+    }
+    volume->seed = seed;
+    volume->frequency = rules.frequency;
+    volume->threshold = rules.threshold;
+    volume->used = seedClock;
+    if (seedSpill && LoadSeedVolume(commandBuffer, *volume))
+    {
+        return volume->texture;
+    }
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = volume->texture;
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return nullptr;
+    }
+    decltype(rules) seedRules = rules;
+    seedRules.seed = seed;
+    SDL_BindGPUComputePipeline(computePass, seedPipeline);
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &seedRules, sizeof(seedRules));
+    SDL_DispatchGPUCompute(computePass, GetGroups(rules.width), GetGroups(rules.height), GetGroups(rules.depth));
+    SDL_EndGPUComputePass(computePass);
+    return volume->texture;
+}
+
+/* generates at most one of the upcoming seeds per call, in its own submission */
+static void PrefetchSeeds()
+{
+    PollSeedSpills();
+    /* one slot is left for the seed in use so replaying it stays a hit */
+    int prefetch = std::min(SEED_PREFETCH, GetSeedCapacity() - 1);
+    while (int(nextSeeds.size()) < prefetch)
+    {
+        nextSeeds.push_back(std::rand() % RAND_MAX);
+    }
+    for (int i = 0; i < prefetch; i++)
+    {
+        /* queued seeds count as used so generating the next one doesn't evict them */
+        SeedVolume* volume = FindSeedVolume(nextSeeds[i]);
+        if (volume)
+        {
+            volume->used = ++seedClock;
+            continue;
+        }
+        SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
+        if (!commandBuffer)
+        {
+            SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
+            return;
+        }
+        GetSeedVolume(commandBuffer, nextSeeds[i]);
+        SDL_SubmitGPUCommandBuffer(commandBuffer);
+        return;
+    }
+}
+
+static bool CreateResources()
+{
+    SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
+    if (!commandBuffer)
+    {
+        SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
+        return false;
+    }
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    if (!copyPass)
+    {
+        SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+        return false;
+    }
+    {
+        float vertices[36 * 3] =
+        {
+           -0.5f,-0.5f, 0.5f,
+            0.5f,-0.5f, 0.5f,
+            0.5f, 0.5f, 0.5f,
+           -0.5f,-0.5f, 0.5f,
+            0.5f, 0.5f, 0.5f,
+           -0.5f, 0.5f, 0.5f,
+           -0.5f,-0.5f,-0.5f,
+            0.5f, 0.5f,-0.5f,
+            0.5f,-0.5f,-0.5f,
+           -0.5f,-0.5f,-0.5f,
+           -0.5f, 0.5f,-0.5f,
+            0.5f, 0.5f,-0.5f,
+           -0.5f,-0.5f,-0.5f,
+           -0.5f,-0.5f, 0.5f,
+           -0.5f, 0.5f, 0.5f,
+           -0.5f,-0.5f,-0.5f,
+           -0.5f, 0.5f, 0.5f,
+           -0.5f, 0.5f,-0.5f,
+            0.5f,-0.5f,-0.5f,
+            0.5f, 0.5f, 0.5f,
+            0.5f,-0.5f, 0.5f,
+            0.5f,-0.5f,-0.5f,
+            0.5f, 0.5f,-0.5f,
+            0.5f, 0.5f, 0.5f,
+           -0.5f, 0.5f,-0.5f,
+           -0.5f, 0.5f, 0.5f,
+            0.5f, 0.5f, 0.5f,
+           -0.5f, 0.5f,-0.5f,
+            0.5f, 0.5f, 0.5f,
+            0.5f, 0.5f,-0.5f,
+           -0.5f,-0.5f,-0.5f,
+            0.5f,-0.5f, 0.5f,
+           -0.5f,-0.5f, 0.5f,
+           -0.5f,-0.5f,-0.5f,
+            0.5f,-0.5f,-0.5f,
+            0.5f,-0.5f, 0.5f,
+        };
+        SDL_GPUTransferBuffer* transferBuffer;
+        {
+            SDL_GPUTransferBufferCreateInfo info{};
+            info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+            info.size = sizeof(vertices);
+            transferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
+            if (!transferBuffer)
+            {
+                SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
+                return false;
+            }
+        }
+        void* data = SDL_MapGPUTransferBuffer(device, transferBuffer, false);
+        if (!data)
+        {
+            SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
+            return false;
+        }
+        {
+            SDL_GPUBufferCreateInfo info{};
+            info.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
+            info.size = sizeof(vertices);
+            vertexBuffer = SDL_CreateGPUBuffer(device, &info);
+            if (!vertexBuffer)
+            {
+                SDL_Log("Failed to create buffer: %s", SDL_GetError());
+                return false;
+            }
+        }
+        std::memcpy(data, vertices, sizeof(vertices));
+        SDL_GPUTransferBufferLocation location{};
+        SDL_GPUBufferRegion region{};
+        location.transfer_buffer = transferBuffer;
+        region.buffer = vertexBuffer;
+        region.size = sizeof(vertices);
+        SDL_UploadToGPUBuffer(copyPass, &location, &region, false);
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+    }
+    {
+        SDL_GPUBufferCreateInfo info{};
+        info.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE | SDL_GPU_BUFFERUSAGE_INDIRECT;
+        info.size = sizeof(ActiveArgs);
+        argsBuffer = SDL_CreateGPUBuffer(device, &info);
+        if (!argsBuffer)
+        {
+            SDL_Log("Failed to create buffer: %s", SDL_GetError());
+            return false;
+        }
+    }
+    {
+        SDL_GPUTransferBufferCreateInfo info{};
+        info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        info.size = sizeof(ActiveArgs);
+        argsTransferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
+        if (!argsTransferBuffer)
+        {
+            SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
+            return false;
+        }
+        ActiveArgs* data = static_cast<ActiveArgs*>(SDL_MapGPUTransferBuffer(device, argsTransferBuffer, false));
+        if (!data)
+        {
+            SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
+            return false;
+        }
+        /* the compaction pass counts the active bricks and grows the groups up from here */
+        data->dispatch.groupcount_x = 0;
+        data->dispatch.groupcount_y = 0;
+        data->dispatch.groupcount_z = 1;
+        data->count = 0;
+        SDL_UnmapGPUTransferBuffer(device, argsTransferBuffer);
+    }
+    {
+        SDL_GPUBufferCreateInfo info{};
+        info.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ;
+        info.size = sizeof(uint32_t) * (MAX_LIFE + 1) * COUNTS;
+        transitionsBuffer = SDL_CreateGPUBuffer(device, &info);
+        if (!transitionsBuffer)
+        {
+            SDL_Log("Failed to create buffer: %s", SDL_GetError());
+            return false;
+        }
+    }
+    {
+        SDL_GPUTransferBufferCreateInfo info{};
+        info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        info.size = sizeof(uint32_t) * (MAX_LIFE + 1) * COUNTS;
+        transitionsTransferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
+        if (!transitionsTransferBuffer)
+        {
+            SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
+            return false;
+        }
+    }
+    {
+        SDL_GPUBufferCreateInfo info{};
+        info.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+        info.size = sizeof(Stats);
+        statsBuffer = SDL_CreateGPUBuffer(device, &info);
+        if (!statsBuffer)
+        {
+            SDL_Log("Failed to create buffer: %s", SDL_GetError());
+            return false;
+        }
+    }
+    {
+        SDL_GPUTransferBufferCreateInfo info{};
+        info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        info.size = sizeof(Stats);
+        statsResetTransferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
+        if (!statsResetTransferBuffer)
+        {
+            SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
+            return false;
+        }
+        Stats* data = static_cast<Stats*>(SDL_MapGPUTransferBuffer(device, statsResetTransferBuffer, false));
+        if (!data)
+        {
+            SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
+            return false;
+        }
+        /* every generation's statistics are reduced into a copy of this */
+        *data = Stats{};
+        for (int i = 0; i < 3; i++)
+        {
+            data->minimum[i] = UINT32_MAX;
+        }
+        SDL_UnmapGPUTransferBuffer(device, statsResetTransferBuffer);
+    }
+    for (StatsReadback& readback : statsReadbacks)
+    {
+        SDL_GPUTransferBufferCreateInfo info{};
+        info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+        info.size = sizeof(Stats);
+        readback.transferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
+        if (!readback.transferBuffer)
+        {
+            SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
+            return false;
+        }
+    }
+    SDL_EndGPUCopyPass(copyPass);
+    SDL_SubmitGPUCommandBuffer(commandBuffer);
+    return CreateGrid();
+}
+
+static std::string GetShapeName(const Shape& shape)
+{
+    return std::format("{}x{}x{}_{}", shape.x, shape.y, shape.z, shape.cells);
+}
+
+static std::string GetTuningKey()
+{
+    return std::format("{}x{}x{}_{}", rules.width, rules.height, rules.depth, rules.neighborhood);
+}
+
+/* one file per adapter, named after it */
+static std::string GetTuningPath()
+{
+    SDL_PropertiesID properties = SDL_GetGPUDeviceProperties(device);
+    std::string name = SDL_GetStringProperty(properties, SDL_PROP_GPU_DEVICE_NAME_STRING, SDL_GetGPUDeviceDriver(device));
+    for (char& character : name)
+    {
+        if (!std::isalnum(static_cast<unsigned char>(character)))
+        {
+            character = '_';
+        }
+    }
+    return std::format("autotune_{}.txt", name);
+}
+
+static void LoadTunings()
+{
+    std::ifstream file(GetTuningPath());
+    if (file.fail())
+    {
+        return;
+    }
+    std::string key;
+    std::string name;
+    while (file >> key >> name)
+    {
+        for (int i = 0; i < int(std::size(shapes)); i++)
+        {
+            if (GetShapeName(shapes[i]) == name)
+            {
+                tunings[key] = i;
+            }
+        }
+    }
+}
+
+/* one "state neighbors next" per line, entries that aren't listed keep the preset's */
+static bool LoadTransitions()
+{
+    std::ifstream file(transitionsPath);
+    if (file.fail())
+    {
+        SDL_Log("Failed to open transitions: %s", transitionsPath);
+        return false;
+    }
+    std::vector<TransitionOverride> overrides;
+    TransitionOverride entry;
+    while (file >> entry.value >> entry.neighbors >> entry.next)
+    {
+        if (entry.value > MAX_LIFE || entry.neighbors >= COUNTS || entry.next > MAX_LIFE)
+        {
+            SDL_Log("Invalid transition: %u %u %u", entry.value, entry.neighbors, entry.next);
+            return false;
+        }
+        overrides.push_back(entry);
+    }
+    if (!file.eof())
+    {
+        SDL_Log("Failed to parse transitions: %s", transitionsPath);
+        return false;
+    }
+    transitionOverrides = std::move(overrides);
+    SDL_Log("Loaded %zu transitions", transitionOverrides.size());
+    return true;
+}
+
+static void SaveTunings()
+{
+    std::string path = GetTuningPath();
+    std::ofstream file(path);
+    if (file.fail())
+    {
+        SDL_Log("Failed to open tunings: %s", path.data());
+        return;
+    }
+    for (const auto& [key, index] : tunings)
+    {
+        file << key << ' ' << GetShapeName(shapes[index]) << '\n';
+    }
+}
+
+static int GetShape()
+{
+    auto it = tunings.find(GetTuningKey());
+    if (it == tunings.end())
+    {
+        return 0;
+    }
+    return it->second;
+}
+
+static void DrawImGui()
+{
+    ImGui_ImplSDLGPU3_NewFrame();
+    ImGui::NewFrame();
+    ImGui::Begin("Settings");
+    imguiFocused = ImGui::IsWindowFocused();
+    if (ImGui::Button("Reset"))
+    {
+        rules.seed = NextSeed();
+        rules.frame = 0;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Replay"))
+    {
+        rules.frame = 0;
+    }
+    ImGui::SliderFloat("Frequency", &rules.frequency, 0.01f, 0.5f);
+    ImGui::SliderFloat("Threshold", &rules.threshold, -1.0f, 1.0f);
+    ImGui::Checkbox("Spill Seeds", &seedSpill);
+    ImGui::SliderFloat("Speed", &delay, 0.0f, 1000.0f);
+    ImGui::SliderInt("History", &history, 0, FRAMES - 2);
+    ImGui::InputInt3("Size", gridSize);
+    ImGui::SameLine();
+    if (ImGui::Button("Resize"))
+    {
+        resizing = true;
+    }
+    ImGui::Text("Survive");
+    for (int i = 1; i < 27; i++)
+    {
+        bool bit = (rules.surviveMask >> i) & 1;
+        if (i % 7 == 0)
+        {
+            ImGui::NewLine();
+        }
+        ImGui::PushID(i);
+        if (ImGui::Checkbox("", &bit))
+        {
+            if (bit)
+            {
+                rules.surviveMask |= (1 << i);
+            }
+            else
+            {
+                rules.surviveMask &= ~(1 << i);
+            }
+        }
+        ImGui::SameLine();
+        ImGui::Text("%02d", i);
+        ImGui::SameLine();
+        ImGui::PopID();
+    }
+    ImGui::NewLine();
+    ImGui::Text("Birth");
+    for (int i = 1; i < 27; i++)
+    {
+        bool bit = (rules.birthMask >> i) & 1;
+        if (i % 7 == 0)
+        {
+            ImGui::NewLine();
+        }
+        ImGui::PushID(32 + i);
+        if (ImGui::Checkbox("", &bit))
+        {
+            if (bit)
+            {
+                rules.birthMask |= (1 << i);
+            }
+            else
+            {
+                rules.birthMask &= ~(1 << i);
+            }
+        }
+        ImGui::SameLine();
+        ImGui::Text("%02d", i);
+        ImGui::SameLine();
+        ImGui::PopID();
+    }
+    ImGui::NewLine();
+    int life = rules.life;
+    int neighborhood = rules.neighborhood;
+    int boundary = rules.boundary;
+    ImGui::SliderInt("Life", &life, 1, MAX_LIFE);
+    ImGui::Text("Neighborhood");
+    ImGui::RadioButton("Moore", &neighborhood, 0);
+    ImGui::RadioButton("Von Neumann", &neighborhood, 1);
+    ImGui::RadioButton("Box", &neighborhood, BOX);
+    ImGui::RadioButton("Diamond", &neighborhood, DIAMOND);
+    if (neighborhood == BOX || neighborhood == DIAMOND)
+    {
+        int radius = rules.radius;
+        int birth[2] = {int(rules.birthMin), int(rules.birthMax)};
+        int survive[2] = {int(rules.surviveMin), int(rules.surviveMax)};
+        int cells = (2 * RADIUS + 1) * (2 * RADIUS + 1) * (2 * RADIUS + 1);
+        ImGui::SliderInt("Radius", &radius, 1, RADIUS);
+        ImGui::DragInt2("Birth", birth, 1.0f, 0, cells);
+        ImGui::DragInt2("Survive", survive, 1.0f, 0, cells);
+        rules.radius = radius;
+        rules.birthMin = birth[0];
+        rules.birthMax = birth[1];
+        rules.surviveMin = survive[0];
+        rules.surviveMax = survive[1];
+    }
+    rules.life = life;
+    /* turning it on reloads the file, and a new table wakes everything up like a rule change */
+    if (ImGui::Checkbox("Transition Table", &customTransitions))
+    {
+        if (customTransitions && !LoadTransitions())
+        {
+            customTransitions = false;
+        }
+        transitionsDirty = true;
+        universesDirty = true;
+        bricksDirty = FRAMES - 1;
+        statsRun++;
+    }
+    ImGui::Text("Boundary");
+    ImGui::RadioButton("Dead", &boundary, BOUNDARY_DEAD);
+    ImGui::RadioButton("Torus", &boundary, BOUNDARY_TORUS);
+    rules.neighborhood = neighborhood;
+    rules.boundary = boundary;
+    ImGui::Text("Kernel");
+    ImGui::RadioButton("Default", &kernel, KERNEL_DEFAULT);
+    ImGui::RadioButton("Tiled", &kernel, KERNEL_TILED);
+    ImGui::RadioButton("Bitplane", &kernel, KERNEL_BITPLANE);
+    ImGui::RadioButton("Box Sum (Moore)", &kernel, KERNEL_BOXSUM);
+    ImGui::RadioButton("Temporal", &kernel, KERNEL_TEMPORAL);
+    ImGui::RadioButton("Active Bricks", &kernel, KERNEL_ACTIVE);
+    ImGui::RadioButton("Split", &kernel, KERNEL_SPLIT);
+    ImGui::BeginDisabled(!subgroups);
+    ImGui::RadioButton("Subgroup", &kernel, KERNEL_SUBGROUP);
+    ImGui::EndDisabled();
+    if (ImGui::Button("Verify"))
+    {
+        verifying = true;
+    }
+    if (!verification.empty())
+    {
+        ImGui::SameLine();
+        ImGui::Text("%s", verification.data());
+    }
+    if (kernel == KERNEL_DEFAULT)
+    {
+        ImGui::Checkbox("Autotune", &autotune);
+        ImGui::SameLine();
+        ImGui::Text("Shape: %s", GetShapeName(shapes[GetShape()]).data());
+    }
+    ImGui::Checkbox("Pack Nibbles (Life <= 15)", &packing);
+    ImGui::Checkbox("Brick Buffers", &bricking);
+    static const char* layouts[] = {"Bytes", "Nibbles", "Bricks"};
+    ImGui::Text("Storage: %s", layouts[layout]);
+    if (kernel == KERNEL_TEMPORAL)
+    {
+        ImGui::SliderInt("Steps", &temporalSteps, 1, TEMPORAL_STEPS);
+    }
+    ImGui::Text("Batch");
+    ImGui::InputInt2("Universes / Size", batchSettings);
+    ImGui::SameLine();
+    if (ImGui::Button("Apply"))
+    {
+        batching = true;
+    }
+    if (!universes.empty())
+    {
+        const Universe& universe = universes[std::min<int>(viewedUniverse, universes.size() - 1)];
+        ImGui::SliderInt("View", &viewedUniverse, 0, universes.size() - 1);
+        ImGui::Text("Survive %07X Birth %07X", universe.surviveMask, universe.birthMask);
+        if (ImGui::Button("Randomize"))
+        {
+            RandomizeUniverses();
+        }
+    }
+    ImGui::Checkbox("Statistics", &statistics);
+    ImGui::Text("When Extinct, Still or Cycling");
+    ImGui::RadioButton("Ignore", &policy, POLICY_OFF);
+    ImGui::SameLine();
+    ImGui::RadioButton("Report", &policy, POLICY_REPORT);
+    ImGui::SameLine();
+    ImGui::RadioButton("Pause", &policy, POLICY_PAUSE);
+    ImGui::SameLine();
+    ImGui::RadioButton("Reset", &policy, POLICY_RESET);
+    ImGui::Checkbox("Paused", &paused);
+    if (!detection.empty())
+    {
+        ImGui::SameLine();
+        ImGui::Text("%s", detection.data());
+    }
+    if (statistics && (layout != LAYOUT_BYTES || IsBatching()))
+    {
+        ImGui::Text("Only measured with bytes and no batch");
+    }
+    else if (statistics)
+    {
+        ImGui::Text("Frame %u: %u alive, %u births, %u deaths", statsFrame, stats.alive, stats.births, stats.deaths);
+        if (stats.alive > 0)
+        {
+            ImGui::Text("Bounds (%u, %u, %u) to (%u, %u, %u)", stats.minimum[0], stats.minimum[1], stats.minimum[2],
+                stats.maximum[0], stats.maximum[1], stats.maximum[2]);
+        }
+        /* newborns (state life) first, then the dying ones counting down */
+        float ages[MAX_LIFE];
+        for (uint32_t age = 0; age < rules.life; age++)
+        {
+            ages[age] = stats.states[rules.life - age];
+        }
+        ImGui::PlotHistogram("Ages", ages, rules.life, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+    }
+    ImGui::End();
+    ImGui::Render();
+}
+
+static void Draw()
+{
+    SDL_WaitForGPUSwapchain(device, window);
+    SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
+    if (!commandBuffer)
+    {
+        SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
+        return;
+    }
+    SDL_GPUTexture* texture;
+    uint32_t width;
+    uint32_t height;
+    if (!SDL_AcquireGPUSwapchainTexture(commandBuffer, window, &texture, &width, &height))
+    {
+        SDL_Log("Failed to acquire swapchain texture: %s", SDL_GetError());
+        SDL_CancelGPUCommandBuffer(commandBuffer);
+        return;
+    }
+    if (!texture || !width || !height)
+    {
+        /* happens on minimize */
+        SDL_SubmitGPUCommandBuffer(commandBuffer);
+        return;
+    }
+    if (width != depthTextureWidth || height != depthTextureHeight)
+    {
+        SDL_ReleaseGPUTexture(device, depthTexture);
+        SDL_GPUTextureCreateInfo info{};
+        info.type = SDL_GPU_TEXTURETYPE_2D;
+        info.format = SDL_GPU_TEXTUREFORMAT_D32_FLOAT;
+        info.usage = SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET;
+        info.width = width;
+        info.height = height;
+        info.layer_count_or_depth = 1;
+        info.num_levels = 1;
+        info.props = SDL_CreateProperties();
+        SDL_SetFloatProperty(info.props, SDL_PROP_GPU_TEXTURE_CREATE_D3D12_CLEAR_DEPTH_FLOAT, 1.0f);
+        depthTexture = SDL_CreateGPUTexture(device, &info);
+        SDL_DestroyProperties(info.props);
+        if (!depthTexture)
+        {
+            SDL_Log("Failed to create texture: %s", SDL_GetError());
+            SDL_SubmitGPUCommandBuffer(commandBuffer);
+            return;
+        }
+        depthTextureWidth = width;
+        depthTextureHeight = height;
+    }
+    glm::vec3 vector;
+    vector.x = std::cos(pitch) * std::cos(yaw);
+    vector.y = std::sin(pitch);
+    vector.z = std::cos(pitch) * std::sin(yaw);
+    float ratio = static_cast<float>(width) / height;
+    /* the newest generation, or an older one still in the ring, is drawn while the next one is written */
+    int drawFrame = (readFrame - history + FRAMES) % FRAMES;
+    /* when batching, only the viewed universe is drawn */
+    SDL_GPUTexture* cells = textures[drawFrame];
+    decltype(rules) viewRules = rules;
+    uint32_t offset[3]{};
+    if (IsBatching())
+    {
+        int universe = std::min<int>(viewedUniverse, universes.size() - 1);
+        cells = batchTextures[drawFrame];
+        viewRules.width = universeSize;
+        viewRules.height = universeSize;
+        viewRules.depth = universeSize;
+        viewRules.life = universes[universe].life;
+        offset[0] = universe % universeTiles[0] * universeSize;
+        offset[1] = universe / universeTiles[0] % universeTiles[1] * universeSize;
+        offset[2] = universe / (universeTiles[0] * universeTiles[1]) * universeSize;
+    }
+    glm::vec3 center = glm::vec3{viewRules.width, viewRules.height, viewRules.depth} / 2.0f;
+    glm::vec3 position = center - vector * distance;
+    glm::mat4 view = glm::lookAt(position, position + vector, glm::vec3{0.0f, 1.0f, 0.0f});
+    glm::mat4 proj = glm::perspective(FOV, ratio, NEAR, FAR);
+    struct
+    {
+        glm::mat4 viewProjMatrix;
+        uint32_t width;
+        uint32_t height;
+        uint32_t depth;
+        uint32_t offsetX;
+        uint32_t offsetY;
+        uint32_t offsetZ;
+    }
+    uniformView;
+    uniformView.viewProjMatrix = proj * view;
+    uniformView.width = viewRules.width;
+    uniformView.height = viewRules.height;
+    uniformView.depth = viewRules.depth;
+    uniformView.offsetX = offset[0];
+    uniformView.offsetY = offset[1];
+    uniformView.offsetZ = offset[2];
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize.x = width;
+    io.DisplaySize.y = height;
+    DrawImGui();
+    ImDrawData* drawData = ImGui::GetDrawData();
+    ImGui_ImplSDLGPU3_PrepareDrawData(drawData, commandBuffer);
+    {
+        SDL_GPUColorTargetInfo colorInfo{};
+        SDL_GPUDepthStencilTargetInfo depthInfo{};
+        colorInfo.texture = texture;
+        colorInfo.load_op = SDL_GPU_LOADOP_CLEAR;
+        colorInfo.store_op = SDL_GPU_STOREOP_STORE;
+        depthInfo.texture = depthTexture;
+        depthInfo.load_op = SDL_GPU_LOADOP_CLEAR;
+        depthInfo.stencil_load_op = SDL_GPU_LOADOP_CLEAR;
+        depthInfo.store_op = SDL_GPU_STOREOP_STORE;
+        depthInfo.clear_depth = 1.0f;
+        depthInfo.cycle = true;
+        SDL_GPURenderPass* renderPass = SDL_BeginGPURenderPass(commandBuffer, &colorInfo, 1, &depthInfo);
+        if (!renderPass)
+        {
+            SDL_Log("Failed to begin render pass: %s", SDL_GetError());
+            SDL_SubmitGPUCommandBuffer(commandBuffer);
+            return;
+        }
+        if (IsBatching() || layout == LAYOUT_BYTES)
+        {
+            SDL_BindGPUGraphicsPipeline(renderPass, graphicsPipeline);
+        }
+        else if (layout == LAYOUT_NIBBLES)
+        {
+            SDL_BindGPUGraphicsPipeline(renderPass, nibbleGraphicsPipeline);
+        }
+        else
+        {
+            SDL_BindGPUGraphicsPipeline(renderPass, bricksGraphicsPipeline);
+        }
+        SDL_GPUBufferBinding vertexBufferBinding{};
+        vertexBufferBinding.buffer = vertexBuffer;
+        SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBufferBinding, 1);
+        if (!IsBatching() && layout == LAYOUT_BRICKS)
+        {
+            SDL_BindGPUVertexStorageBuffers(renderPass, 0, &cellsBuffers[drawFrame], 1);
+        }
+        else
+        {
+            SDL_BindGPUVertexStorageTextures(renderPass, 0, &cells, 1);
+        }
+        SDL_PushGPUVertexUniformData(commandBuffer, 0, &uniformView, sizeof(uniformView));
+        SDL_PushGPUFragmentUniformData(commandBuffer, 0, &viewRules, sizeof(viewRules));
+        SDL_DrawGPUPrimitives(renderPass, 36, viewRules.width * viewRules.height * viewRules.depth, 0, 0);
+        SDL_EndGPURenderPass(renderPass);
+    }
+    {
+        SDL_GPUColorTargetInfo info{};
+        info.texture = texture;
+        info.load_op = SDL_GPU_LOADOP_LOAD;
+        info.store_op = SDL_GPU_STOREOP_STORE;
+        SDL_GPURenderPass* renderPass = SDL_BeginGPURenderPass(commandBuffer, &info, 1, nullptr);
+        if (!renderPass)
+        {
+            SDL_Log("Failed to begin render pass: %s", SDL_GetError());
+            SDL_SubmitGPUCommandBuffer(commandBuffer);
+            return;
+        }
+        ImGui_ImplSDLGPU3_RenderDrawData(drawData, commandBuffer, renderPass);
+        SDL_EndGPURenderPass(renderPass);
+    }
+    SDL_SubmitGPUCommandBuffer(commandBuffer);
+}
+
+static void Pack(SDL_GPUCommandBuffer* commandBuffer)
+{
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = planes[readFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_BindGPUComputePipeline(computePass, packPipeline);
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_BindGPUComputeStorageTextures(computePass, 0, &textures[readFrame], 1);
+    SDL_DispatchGPUCompute(computePass, GetGroups(GetWords()), GetGroups(rules.height), GetGroups(rules.depth));
+    SDL_EndGPUComputePass(computePass);
+}
+
+static void SimulateBitplane(SDL_GPUCommandBuffer* commandBuffer)
+{
+    SDL_GPUStorageTextureReadWriteBinding textureBindings[2]{};
+    textureBindings[0].texture = textures[writeFrame];
+    textureBindings[1].texture = planes[writeFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, textureBindings, 2, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_GPUTexture* readTextures[2] = {planes[readFrame], textures[readFrame]};
+    SDL_BindGPUComputePipeline(computePass, bitplanePipeline);
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_BindGPUComputeStorageTextures(computePass, 0, readTextures, 2);
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, &transitionsBuffer, 1);
+    SDL_DispatchGPUCompute(computePass, GetGroups(GetWords()), GetGroups(rules.height), GetGroups(rules.depth));
+    SDL_EndGPUComputePass(computePass);
+}
+
+static void SimulateBoxsum(SDL_GPUCommandBuffer* commandBuffer)
+{
+    int groupsX = GetGroups(rules.width);
+    int groupsY = GetGroups(rules.height);
+    int groupsZ = GetGroups(rules.depth);
+    /* running sums along x, y and z, ping-ponging through the two sum textures */
+    SDL_GPUTexture* inputs[3] = {textures[readFrame], sums[0], sums[1]};
+    SDL_GPUTexture* outputs[3] = {sums[0], sums[1], sums[0]};
+    for (int axis = 0; axis < 3; axis++)
+    {
+        SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+        textureBinding.texture = outputs[axis];
+        SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+        if (!computePass)
+        {
+            SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+            return;
+        }
+        SDL_BindGPUComputePipeline(computePass, boxsumPipeline);
+        SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+        SDL_PushGPUComputeUniformData(commandBuffer, 1, &axis, sizeof(axis));
+        SDL_BindGPUComputeStorageTextures(computePass, 0, &inputs[axis], 1);
+        SDL_DispatchGPUCompute(computePass, groupsX, groupsY, groupsZ);
+        SDL_EndGPUComputePass(computePass);
+    }
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = textures[writeFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_GPUTexture* readTextures[2] = {textures[readFrame], sums[0]};
+    SDL_BindGPUComputePipeline(computePass, boxrulePipeline);
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_BindGPUComputeStorageTextures(computePass, 0, readTextures, 2);
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, &transitionsBuffer, 1);
+    SDL_DispatchGPUCompute(computePass, groupsX, groupsY, groupsZ);
+    SDL_EndGPUComputePass(computePass);
+}
+
+static void SimulateTemporal(SDL_GPUCommandBuffer* commandBuffer)
+{
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = textures[writeFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_BindGPUComputePipeline(computePass, temporalPipeline);
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_PushGPUComputeUniformData(commandBuffer, 1, &temporalSteps, sizeof(temporalSteps));
+    SDL_BindGPUComputeStorageTextures(computePass, 0, &textures[readFrame], 1);
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, &transitionsBuffer, 1);
+    /* each group writes only the part of its tile that's still valid after all the steps */
+    int interior = TEMPORAL_TILE - 2 * temporalSteps;
+    int groupsX = (rules.width + interior - 1) / interior;
+    int groupsY = (rules.height + interior - 1) / interior;
+    int groupsZ = (rules.depth + interior - 1) / interior;
+    SDL_DispatchGPUCompute(computePass, groupsX, groupsY, groupsZ);
+    SDL_EndGPUComputePass(computePass);
+}
+
+static void SimulateActive(SDL_GPUCommandBuffer* commandBuffer)
+{
+    struct
+    {
+        uint32_t readSlot;
+        uint32_t writeSlot;
+        uint32_t full;
+    }
+    slots;
+    slots.readSlot = readFrame;
+    slots.writeSlot = writeFrame;
+    slots.full = bricksDirty > 0;
+    {
+        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+        if (!copyPass)
+        {
+            SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+            return;
+        }
+        SDL_GPUTransferBufferLocation location{};
+        SDL_GPUBufferRegion region{};
+        location.transfer_buffer = argsTransferBuffer;
+        region.buffer = argsBuffer;
+        region.size = sizeof(ActiveArgs);
+        SDL_UploadToGPUBuffer(copyPass, &location, &region, false);
+        SDL_EndGPUCopyPass(copyPass);
+    }
+    {
+        SDL_GPUStorageBufferReadWriteBinding bufferBindings[3]{};
+        bufferBindings[0].buffer = flagsBuffer;
+        bufferBindings[1].buffer = bricksBuffer;
+        bufferBindings[2].buffer = argsBuffer;
+        SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, nullptr, 0, bufferBindings, 3);
+        if (!computePass)
+        {
+            SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+            return;
+        }
+        SDL_BindGPUComputePipeline(computePass, compactPipeline);
+        SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+        SDL_PushGPUComputeUniformData(commandBuffer, 1, &slots, sizeof(slots));
+        SDL_DispatchGPUCompute(computePass, (GetBrickCount() + 63) / 64, 1, 1);
+        SDL_EndGPUComputePass(computePass);
+    }
+    {
+        SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+        SDL_GPUStorageBufferReadWriteBinding bufferBinding{};
+        textureBinding.texture = textures[writeFrame];
+        bufferBinding.buffer = flagsBuffer;
+        SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, &bufferBinding, 1);
+        if (!computePass)
+        {
+            SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+            return;
+        }
+        SDL_BindGPUComputePipeline(computePass, activePipeline);
+        SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+        SDL_PushGPUComputeUniformData(commandBuffer, 1, &slots, sizeof(slots));
+        SDL_GPUBuffer* readBuffers[3] = {bricksBuffer, transitionsBuffer, argsBuffer};
+        SDL_BindGPUComputeStorageTextures(computePass, 0, &textures[readFrame], 1);
+        SDL_BindGPUComputeStorageBuffers(computePass, 0, readBuffers, 3);
+        SDL_DispatchGPUComputeIndirect(computePass, argsBuffer, 0);
+        SDL_EndGPUComputePass(computePass);
+    }
+}
+
+static void DispatchRegion(SDL_GPUComputePass* computePass, SDL_GPUCommandBuffer* commandBuffer,
+    int minX, int minY, int minZ, int maxX, int maxY, int maxZ)
+{
+    if (minX >= maxX || minY >= maxY || minZ >= maxZ)
+    {
+        return;
+    }
+    int offset[3] = {minX, minY, minZ};
+    SDL_PushGPUComputeUniformData(commandBuffer, 1, offset, sizeof(offset));
+    SDL_DispatchGPUCompute(computePass, maxX - minX, maxY - minY, maxZ - minZ);
+}
+
+/* the variant of a kernel specialized for the current rules, see add_shader_variants */
+static SDL_GPUComputePipeline* GetVariant(const std::string_view& name, SDL_GPUComputePipeline* fallback)
+{
+    static const char* neighborhoods[] = {"moore", "von_neumann"};
+    static const char* boundaries[] = {"dead", "torus"};
+    if (rules.neighborhood > VON_NEUMANN)
+    {
+        return fallback;
+    }
+    std::string variant = std::format("{}_{}_{}.comp",
+        name, neighborhoods[rules.neighborhood], boundaries[rules.boundary]);
+    SDL_GPUComputePipeline* pipeline = GetComputePipeline(device, variant);
+    if (!pipeline)
+    {
+        return fallback;
+    }
+    return pipeline;
+}
+
+static void SimulateSplit(SDL_GPUCommandBuffer* commandBuffer)
+{
+    SDL_GPUComputePipeline* interior = GetVariant("interior", interiorPipeline);
+    SDL_GPUComputePipeline* border = GetVariant("border", borderPipeline);
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = textures[writeFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_BindGPUComputeStorageTextures(computePass, 0, &textures[readFrame], 1);
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, &transitionsBuffer, 1);
+    int groupsX = GetGroups(rules.width);
+    int groupsY = GetGroups(rules.height);
+    int groupsZ = GetGroups(rules.depth);
+    /* interior bricks are [1, 1 + n) on each axis, where every cell's neighbors are inside the grid */
+    int interiorX = std::max(0, (int(rules.width) - 1) / THREADS - 1);
+    int interiorY = std::max(0, (int(rules.height) - 1) / THREADS - 1);
+    int interiorZ = std::max(0, (int(rules.depth) - 1) / THREADS - 1);
+    if (!interiorX || !interiorY || !interiorZ)
+    {
+        SDL_BindGPUComputePipeline(computePass, border);
+        DispatchRegion(computePass, commandBuffer, 0, 0, 0, groupsX, groupsY, groupsZ);
+        SDL_EndGPUComputePass(computePass);
+        return;
+    }
+    SDL_BindGPUComputePipeline(computePass, interior);
+    DispatchRegion(computePass, commandBuffer, 1, 1, 1, 1 + interiorX, 1 + interiorY, 1 + interiorZ);
+    /* the shell around the interior as six slabs */
+    SDL_BindGPUComputePipeline(computePass, border);
+    DispatchRegion(computePass, commandBuffer, 0, 0, 0, groupsX, groupsY, 1);
+    DispatchRegion(computePass, commandBuffer, 0, 0, 1 + interiorZ, groupsX, groupsY, groupsZ);
+    DispatchRegion(computePass, commandBuffer, 0, 0, 1, groupsX, 1, 1 + interiorZ);
+    DispatchRegion(computePass, commandBuffer, 0, 1 + interiorY, 1, groupsX, groupsY, 1 + interiorZ);
+    DispatchRegion(computePass, commandBuffer, 0, 1, 1, 1, 1 + interiorY, 1 + interiorZ);
+    DispatchRegion(computePass, commandBuffer, 1 + interiorX, 1, 1, groupsX, 1 + interiorY, 1 + interiorZ);
+    SDL_EndGPUComputePass(computePass);
+}
+
+static void SimulateLargerThanLife(SDL_GPUCommandBuffer* commandBuffer)
+{
+    /* only allocated once a larger than life neighborhood is used, it's 4 bytes per cell */
+    if (!prefix)
+    {
+        SDL_GPUTextureUsageFlags usage =
+            SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ |
+            SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE;
+        prefix = CreateVolume(SDL_GPU_TEXTUREFORMAT_R32_UINT, usage, rules.width, rules.height, rules.depth);
+        if (!prefix)
+        {
+            return;
+        }
+    }
+    int groupsX = GetGroups(rules.width);
+    int groupsY = GetGroups(rules.height);
+    int groupsZ = GetGroups(rules.depth);
+    {
+        SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+        textureBinding.texture = prefix;
+        SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+        if (!computePass)
+        {
+            SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+            return;
+        }
+        SDL_BindGPUComputePipeline(computePass, prefixPipeline);
+        SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+        SDL_BindGPUComputeStorageTextures(computePass, 0, &textures[readFrame], 1);
+        SDL_DispatchGPUCompute(computePass, groupsY, groupsZ, 1);
+        SDL_EndGPUComputePass(computePass);
+    }
+    /* diamonds only need the x prefix, boxes need the full summed-volume table */
+    if (rules.neighborhood == BOX)
+    {
+        int groups[3][2] = {{}, {groupsX, groupsZ}, {groupsX, groupsY}};
+        for (int axis = 1; axis < 3; axis++)
+        {
+            SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+            textureBinding.texture = prefix;
+            SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+            if (!computePass)
+            {
+                SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+                return;
+            }
+            SDL_BindGPUComputePipeline(computePass, scanPipeline);
+            SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+            SDL_PushGPUComputeUniformData(commandBuffer, 1, &axis, sizeof(axis));
+            SDL_DispatchGPUCompute(computePass, groups[axis][0], groups[axis][1], 1);
+            SDL_EndGPUComputePass(computePass);
+        }
+    }
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = textures[writeFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_GPUTexture* readTextures[2] = {textures[readFrame], prefix};
+    SDL_BindGPUComputePipeline(computePass, ltlPipeline);
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_BindGPUComputeStorageTextures(computePass, 0, readTextures, 2);
+    SDL_DispatchGPUCompute(computePass, groupsX, groupsY, groupsZ);
+    SDL_EndGPUComputePass(computePass);
+}
+
+static SDL_GPUComputePipeline* GetShapePipeline(int index)
+{
+    if (index == 0)
+    {
+        return GetVariant("automata", computePipeline);
+    }
+    std::string name = std::format("automata_{}", GetShapeName(shapes[index]));
+    SDL_GPUComputePipeline* pipeline = GetComputePipeline(device, name + ".comp");
+    if (!pipeline)
+    {
+        return nullptr;
+    }
+    return GetVariant(name, pipeline);
+}
+
+/* the default kernel in one of the shapes, shapes that failed to load use the first */
+static void DispatchShape(SDL_GPUCommandBuffer* commandBuffer, int index)
+{
+    SDL_GPUComputePipeline* pipeline = GetShapePipeline(index);
+    if (!pipeline)
+    {
+        index = 0;
+        pipeline = GetShapePipeline(0);
+    }
+    const Shape& shape = shapes[index];
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = textures[writeFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    int groupsX = (rules.width + shape.x - 1) / shape.x;
+    int groupsY = (rules.height + shape.y - 1) / shape.y;
+    int groupsZ = (rules.depth + shape.z * shape.cells - 1) / (shape.z * shape.cells);
+    SDL_BindGPUComputePipeline(computePass, pipeline);
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_BindGPUComputeStorageTextures(computePass, 0, &textures[readFrame], 1);
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, &transitionsBuffer, 1);
+    SDL_DispatchGPUCompute(computePass, groupsX, groupsY, groupsZ);
+    SDL_EndGPUComputePass(computePass);
+}
+
+static void SimulateTextures(SDL_GPUCommandBuffer* commandBuffer, int simulated)
+{
+    if (simulated == KERNEL_DEFAULT)
+    {
+        DispatchShape(commandBuffer, GetShape());
+        return;
+    }
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = textures[writeFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_GPUComputePipeline* pipeline = GetVariant("automata", computePipeline);
+    if (simulated == KERNEL_TILED)
+    {
+        pipeline = GetVariant("tiled", tiledPipeline);
+    }
+    /* devices without working subgroup shuffles use the default kernel */
+    if (simulated == KERNEL_SUBGROUP && subgroups && GetComputePipeline(device, "subgroup.comp"))
+    {
+        pipeline = GetVariant("subgroup", GetComputePipeline(device, "subgroup.comp"));
+    }
+    SDL_BindGPUComputePipeline(computePass, pipeline);
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_BindGPUComputeStorageTextures(computePass, 0, &textures[readFrame], 1);
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, &transitionsBuffer, 1);
+    SDL_DispatchGPUCompute(computePass, GetGroups(rules.width), GetGroups(rules.height), GetGroups(rules.depth));
+    SDL_EndGPUComputePass(computePass);
+}
+
+/* the survive/birth masks and life as one preset table, other totalistic rules only need a different table */
+static void BuildTransitions(uint32_t table[MAX_LIFE + 1][COUNTS], uint32_t surviveMask, uint32_t birthMask, uint32_t life)
+{
+    for (uint32_t value = 0; value <= MAX_LIFE; value++)
+    {
+        for (uint32_t neighbors = 0; neighbors < COUNTS; neighbors++)
+        {
+            bool birth = birthMask & (1u << neighbors);
+            bool survive = surviveMask & (1u << neighbors);
+            uint32_t next = value;
+            if (value == 0 && birth)
+            {
+                next = life;
+            }
+            else if (!survive && value > 0)
+            {
+                next = value - 1;
+            }
+            table[value][neighbors] = next;
+        }
+    }
+}
+
+/* the loaded table on top of the preset, with states past life clamped to it */
+static void ApplyTransitions(uint32_t table[MAX_LIFE + 1][COUNTS], uint32_t life)
+{
+    if (!customTransitions)
+    {
+        return;
+    }
+    for (const TransitionOverride& entry : transitionOverrides)
+    {
+        table[entry.value][entry.neighbors] = std::min(entry.next, life);
+    }
+}
+
+static void UploadTransitions(SDL_GPUCommandBuffer* commandBuffer)
+{
+    uint32_t (*table)[COUNTS] = static_cast<uint32_t (*)[COUNTS]>(
+        SDL_MapGPUTransferBuffer(device, transitionsTransferBuffer, true));
+    if (!table)
+    {
+        SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
+        return;
+    }
+    BuildTransitions(table, rules.surviveMask, rules.birthMask, rules.life);
+    ApplyTransitions(table, rules.life);
+    SDL_UnmapGPUTransferBuffer(device, transitionsTransferBuffer);
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    if (!copyPass)
+    {
+        SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_GPUTransferBufferLocation location{};
+    SDL_GPUBufferRegion region{};
+    location.transfer_buffer = transitionsTransferBuffer;
+    region.buffer = transitionsBuffer;
+    region.size = sizeof(uint32_t) * (MAX_LIFE + 1) * COUNTS;
+    SDL_UploadToGPUBuffer(copyPass, &location, &region, true);
+    SDL_EndGPUCopyPass(copyPass);
+    transitionsDirty = false;
+}
+
+/* only the default kernel on bytes has shapes */
+static bool IsTunable()
+{
+    return kernel == KERNEL_DEFAULT && layout == LAYOUT_BYTES && !IsBatching() && rules.neighborhood <= VON_NEUMANN;
+}
+
+/* wall time of one submission of that many dispatches with a shape, or of an empty one without */
+static uint64_t TimeSubmission(int shape, int steps)
+{
+    SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
+    if (!commandBuffer)
+    {
+        SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
+        return UINT64_MAX;
+    }
+    if (transitionsDirty)
+    {
+        UploadTransitions(commandBuffer);
+    }
+    uint64_t start = SDL_GetTicksNS();
+    for (int step = 0; shape >= 0 && step < steps; step++)
+    {
+        DispatchShape(commandBuffer, shape);
+    }
+    SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(commandBuffer);
+    if (!fence)
+    {
+        SDL_Log("Failed to submit command buffer: %s", SDL_GetError());
+        return UINT64_MAX;
+    }
+    SDL_WaitForGPUFences(device, true, &fence, 1);
+    SDL_ReleaseGPUFence(device, fence);
+    return SDL_GetTicksNS() - start;
+}
+
+/* times every shape on the current grid, writing over the next generation, and keeps the fastest */
+static void Autotune()
+{
+    SDL_WaitForGPUIdle(device);
+    uint64_t cells = uint64_t(rules.width) * rules.height * rules.depth;
+    int steps = int(std::max<uint64_t>(AUTOTUNE_STEPS, AUTOTUNE_CELLS / std::max<uint64_t>(cells, 1)));
+    /* recording, submitting and waiting cost the same for every shape, so an empty submission is subtracted */
+    uint64_t baseline = UINT64_MAX;
+    for (int run = 0; run < 4; run++)
+    {
+        baseline = std::min(baseline, TimeSubmission(-1, 0));
+    }
+    if (baseline == UINT64_MAX)
+    {
+        return;
+    }
+    int fastest = 0;
+    uint64_t fastestTime = UINT64_MAX;
+    for (int i = 0; i < int(std::size(shapes)); i++)
+    {
+        if (!GetShapePipeline(i))
+        {
+            continue;
+        }
+        /* the first run warms the pipeline up and isn't counted */
+        uint64_t time = 0;
+        for (int run = 0; run < 2; run++)
+        {
+            time = TimeSubmission(i, steps);
+            if (time == UINT64_MAX)
+            {
+                return;
+            }
+        }
+        time -= std::min(time, baseline);
+        SDL_Log("Shape %s: %.3f ms", GetShapeName(shapes[i]).data(), time / 1e6 / steps);
+        if (time < fastestTime)
+        {
+            fastest = i;
+            fastestTime = time;
+        }
+    }
+    tunings[GetTuningKey()] = fastest;
+    SaveTunings();
+}
+
+static void UploadUniverses(SDL_GPUCommandBuffer* commandBuffer)
+{
+    uint32_t universesSize = universes.size() * sizeof(Universe);
+    uint32_t transitionsSize = universes.size() * sizeof(uint32_t) * (MAX_LIFE + 1) * COUNTS;
+    SDL_GPUTransferBuffer* transferBuffer;
+    {
+        SDL_GPUTransferBufferCreateInfo info{};
+        info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        info.size = universesSize + transitionsSize;
+        transferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
+        if (!transferBuffer)
+        {
+            SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
+            return;
+        }
+    }
+    uint8_t* data = static_cast<uint8_t*>(SDL_MapGPUTransferBuffer(device, transferBuffer, false));
+    if (!data)
+    {
+        SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return;
+    }
+    std::memcpy(data, universes.data(), universesSize);
+    uint32_t (*tables)[MAX_LIFE + 1][COUNTS] = reinterpret_cast<uint32_t (*)[MAX_LIFE + 1][COUNTS]>(data + universesSize);
+    for (size_t i = 0; i < universes.size(); i++)
+    {
+        BuildTransitions(tables[i], universes[i].surviveMask, universes[i].birthMask, universes[i].life);
+    }
+    /* the first universe keeps the current rules, table included */
+    if (!universes.empty())
+    {
+        ApplyTransitions(tables[0], universes[0].life);
+    }
+    SDL_UnmapGPUTransferBuffer(device, transferBuffer);
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    if (!copyPass)
+    {
+        SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return;
+    }
+    SDL_GPUTransferBufferLocation location{};
+    SDL_GPUBufferRegion region{};
+    location.transfer_buffer = transferBuffer;
+    region.buffer = universesBuffer;
+    region.size = universesSize;
+    SDL_UploadToGPUBuffer(copyPass, &location, &region, false);
+    location.offset = universesSize;
+    region.buffer = batchTransitionsBuffer;
+    region.size = transitionsSize;
+    SDL_UploadToGPUBuffer(copyPass, &location, &region, false);
+    SDL_EndGPUCopyPass(copyPass);
+    SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+    universesDirty = false;
+}
+
+static void PushBatch(SDL_GPUCommandBuffer* commandBuffer)
+{
+    /* the kernels see the bounds of a single universe */
+    decltype(rules) batchRules = rules;
+    batchRules.width = universeSize;
+    batchRules.height = universeSize;
+    batchRules.depth = universeSize;
+    struct
+    {
+        uint32_t universesX;
+        uint32_t universesY;
+        uint32_t universesZ;
+        uint32_t count;
+    }
+    batch;
+    batch.universesX = universeTiles[0];
+    batch.universesY = universeTiles[1];
+    batch.universesZ = universeTiles[2];
+    batch.count = universes.size();
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &batchRules, sizeof(batchRules));
+    SDL_PushGPUComputeUniformData(commandBuffer, 1, &batch, sizeof(batch));
+}
+
+static void SimulateBatch(SDL_GPUCommandBuffer* commandBuffer)
+{
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = batchTextures[writeFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_GPUBuffer* readBuffers[2] = {universesBuffer, batchTransitionsBuffer};
+    SDL_BindGPUComputePipeline(computePass, batchPipeline);
+    PushBatch(commandBuffer);
+    SDL_BindGPUComputeStorageTextures(computePass, 0, &batchTextures[readFrame], 1);
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, readBuffers, 2);
+    int groupsX = GetGroups(universeTiles[0] * universeSize);
+    int groupsY = GetGroups(universeTiles[1] * universeSize);
+    int groupsZ = GetGroups(universeTiles[2] * universeSize);
+    SDL_DispatchGPUCompute(computePass, groupsX, groupsY, groupsZ);
+    SDL_EndGPUComputePass(computePass);
+}
+
+static void SimulateNibble(SDL_GPUCommandBuffer* commandBuffer)
+{
+    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+    textureBinding.texture = textures[writeFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_BindGPUComputePipeline(computePass, nibblePipeline);
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_BindGPUComputeStorageTextures(computePass, 0, &textures[readFrame], 1);
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, &transitionsBuffer, 1);
+    SDL_DispatchGPUCompute(computePass, GetGroups(GetNibbles()), GetGroups(rules.height), GetGroups(rules.depth));
+    SDL_EndGPUComputePass(computePass);
+}
+
+static void Seed(SDL_GPUCommandBuffer* commandBuffer)
+{
+    if (!IsBatching())
+    {
+        SDL_GPUTexture* source = GetSeedVolume(commandBuffer, rules.seed);
+        if (!source)
+        {
+            return;
+        }
+        /* the rest of the ring starts out as the seed too, so the history is never garbage */
+        PackBytes(commandBuffer, source, writeFrame);
+        FillRing(commandBuffer, writeFrame);
+        return;
+    }
+    /* every universe has its own seed, so the batch isn't cached */
+    if (universesDirty)
+    {
+        UploadUniverses(commandBuffer);
+    }
+    int width = universeTiles[0] * universeSize;
+    int height = universeTiles[1] * universeSize;
+    int depth = universeTiles[2] * universeSize;
+    {
+        SDL_GPUStorageTextureReadWriteBinding textureBinding{};
+        textureBinding.texture = batchTextures[writeFrame];
+        SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+        if (!computePass)
+        {
+            SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+            return;
+        }
+        SDL_BindGPUComputePipeline(computePass, seedBatchPipeline);
+        SDL_BindGPUComputeStorageBuffers(computePass, 0, &universesBuffer, 1);
+        PushBatch(commandBuffer);
+        SDL_DispatchGPUCompute(computePass, GetGroups(width), GetGroups(height), GetGroups(depth));
+        SDL_EndGPUComputePass(computePass);
+    }
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    if (!copyPass)
+    {
+        SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+        return;
+    }
+    for (int i = 0; i < FRAMES; i++)
+    {
+        if (i == writeFrame)
+        {
+            continue;
+        }
+        SDL_GPUTextureLocation source{};
+        SDL_GPUTextureLocation destination{};
+        source.texture = batchTextures[writeFrame];
+        destination.texture = batchTextures[i];
+        SDL_CopyGPUTextureToTexture(copyPass, &source, &destination, width, height, depth, false);
+    }
+    SDL_EndGPUCopyPass(copyPass);
+}
+
+static void SimulateBricks(SDL_GPUCommandBuffer* commandBuffer)
+{
+    SDL_GPUStorageBufferReadWriteBinding bufferBinding{};
+    bufferBinding.buffer = cellsBuffers[writeFrame];
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, nullptr, 0, &bufferBinding, 1);
+    if (!computePass)
+    {
+        SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+        return;
+    }
+    SDL_GPUBuffer* readBuffers[2] = {cellsBuffers[readFrame], transitionsBuffer};
+    SDL_BindGPUComputePipeline(computePass, GetVariant("brick", brickPipeline));
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, readBuffers, 2);
+    SDL_DispatchGPUCompute(computePass, GetCellBricks(rules.width), GetCellBricks(rules.height), GetCellBricks(rules.depth));
+    SDL_EndGPUComputePass(computePass);
+}
+
+/* reduces the generation just written against the one it came from, without waiting on earlier downloads */
+static StatsReadback* Measure(SDL_GPUCommandBuffer* commandBuffer)
+{
+    StatsReadback* readback = nullptr;
+    for (StatsReadback& candidate : statsReadbacks)
+    {
+        if (!candidate.fence)
+        {
+            readback = &candidate;
+            break;
+        }
+    }
+    /* every download is still in flight, so this generation is skipped */
+    if (!readback)
+    {
+        return nullptr;
+    }
+    {
+        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+        if (!copyPass)
+        {
+            SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+            return nullptr;
+        }
+        SDL_GPUTransferBufferLocation location{};
+        SDL_GPUBufferRegion region{};
+        location.transfer_buffer = statsResetTransferBuffer;
+        region.buffer = statsBuffer;
+        region.size = sizeof(Stats);
+        SDL_UploadToGPUBuffer(copyPass, &location, &region, false);
+        SDL_EndGPUCopyPass(copyPass);
+    }
+    {
+        SDL_GPUStorageBufferReadWriteBinding bufferBinding{};
+        bufferBinding.buffer = statsBuffer;
+        SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, nullptr, 0, &bufferBinding, 1);
+        if (!computePass)
+        {
+            SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
+            return nullptr;
+        }
+        SDL_GPUTexture* cells[2] = {textures[readFrame], textures[writeFrame]};
+        int groupsZ = (rules.depth + THREADS * STATS_CELLS - 1) / (THREADS * STATS_CELLS);
+        SDL_BindGPUComputePipeline(computePass, statsPipeline);
+        SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
+        SDL_BindGPUComputeStorageTextures(computePass, 0, cells, 2);
+        SDL_DispatchGPUCompute(computePass, GetGroups(rules.width), GetGroups(rules.height), groupsZ);
+        SDL_EndGPUComputePass(computePass);
+    }
+    {
+        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+        if (!copyPass)
+        {
+            SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+            return nullptr;
+        }
+        SDL_GPUBufferRegion region{};
+        SDL_GPUTransferBufferLocation location{};
+        region.buffer = statsBuffer;
+        region.size = sizeof(Stats);
+        location.transfer_buffer = readback->transferBuffer;
+        SDL_DownloadFromGPUBuffer(copyPass, &region, &location);
+        SDL_EndGPUCopyPass(copyPass);
+    }
+    return readback;
+}
+
+/* generations can be skipped, so a repeat only says the period divides the distance between the two */
+static void Detect(const Stats& data, uint32_t frame, uint64_t run)
+{
+    /* generations of an older run or older rules would match by accident */
+    if (run != statsRun)
+    {
+        return;
+    }
+    if (hashesRun != run)
+    {
+        hashes.clear();
+        hashesRun = run;
+    }
+    if (policy == POLICY_OFF || detectedRun == run)
+    {
+        return;
+    }
+    auto matches = [&](const StatsHash& previous)
+    {
+        return previous.alive == data.alive && !std::memcmp(previous.hash, data.hash, sizeof(data.hash));
+    };
+    std::string found;
+    if (data.alive == 0)
+    {
+        found = std::format("Extinct at frame {}", frame);
+    }
+    /* the hash covers the states, so decaying cells under an unchanged alive set don't look still,
+     * and the seed was copied to the whole ring, so frame 1 looks still */
+    else if (frame > 1 && !hashes.empty() && hashes.back().frame + 1 == frame && matches(hashes.back()))
+    {
+        found = std::format("Still at frame {}", frame);
+    }
+    else
+    {
+        for (const StatsHash& previous : hashes)
+        {
+            if (matches(previous))
+            {
+                found = std::format("Period {} at frame {}", frame - previous.frame, frame);
+                break;
+            }
+        }
+    }
+    StatsHash current{frame, data.alive, {data.hash[0], data.hash[1]}};
+    hashes.push_back(current);
+    if (hashes.size() > HASH_WINDOW)
+    {
+        hashes.pop_front();
+    }
+    if (found.empty())
+    {
         return;
     }
-    if (!texture || !width || !height)
+    detection = found;
+    detectedRun = run;
+    SDL_Log("%s", detection.data());
+    switch (policy)
     {
-        /* happens on minimize */
-        SDL_SubmitGPUCommandBuffer(commandBuffer);
-        return;
+    case POLICY_PAUSE:
+        paused = true;
+        break;
+    case POLICY_RESET:
+        rules.seed = NextSeed();
+        rules.frame = 0;
+        break;
     }
-    if (width != depthTextureWidth || height != depthTextureHeight)
+}
+
+/* keeps the newest finished download and hands them all to the detection in order */
+static void PollStats()
+{
+    while (true)
     {
-        SDL_ReleaseGPUTexture(device, depthTexture);
-        SDL_GPUTextureCreateInfo info{};
-        info.type = SDL_GPU_TEXTURETYPE_2D;
-        info.format = SDL_GPU_TEXTUREFORMAT_D32_FLOAT;
-        info.usage = SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET;
-        info.width = width;
-        info.height = height;
-        info.layer_count_or_depth = 1;
-        info.num_levels = 1;
-        info.props = SDL_CreateProperties();
-        SDL_SetFloatProperty(info.props, SDL_PROP_GPU_TEXTURE_CREATE_D3D12_CLEAR_DEPTH_FLOAT, 1.0f);
-        depthTexture = SDL_CreateGPUTexture(device, &info);
-        SDL_DestroyProperties(info.props);
-        if (!depthTexture)
+        StatsReadback* readback = nullptr;
+        for (StatsReadback& candidate : statsReadbacks)
         {
-            SDL_Log("Failed to create texture: %s", SDL_GetError());
-            SDL_SubmitGPUCommandBuffer(commandBuffer);
-            return;
+            if (candidate.fence && SDL_QueryGPUFence(device, candidate.fence) &&
+                (!readback || candidate.clock < readback->clock))
+            {
+                readback = &candidate;
+            }
         }
-        depthTextureWidth = width;
-        depthTextureHeight = height;
+        if (!readback)
+        {
+            break;
+        }
+        const Stats* data = static_cast<const Stats*>(SDL_MapGPUTransferBuffer(device, readback->transferBuffer, false));
+        if (data)
+        {
+            stats = *data;
+            statsFrame = readback->frame;
+            Detect(*data, readback->frame, readback->run);
+            SDL_UnmapGPUTransferBuffer(device, readback->transferBuffer);
+        }
+        else
+        {
+            SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
+        }
+        SDL_ReleaseGPUFence(device, readback->fence);
+        readback->fence = nullptr;
     }
-    glm::vec3 vector;
-    vector.x = std::cos(pitch) * std::cos(yaw);
-    vector.y = std::sin(pitch);
-    vector.z = std::cos(pitch) * std::sin(yaw);
-    float ratio = static_cast<float>(width) / height;
-    glm::vec3 center = glm::vec3{BOUNDS / 2};
-    glm::vec3 position = center - vector * distance;
-    glm::mat4 view = glm::lookAt(position, position + vector, glm::vec3{0.0f, 1.0f, 0.0f});
-    glm::mat4 proj = glm::perspective(FOV, ratio, NEAR, FAR);
-    glm::mat4 viewProjMatrix = proj * view;
-    ImGuiIO& io = ImGui::GetIO();
-    io.DisplaySize.x = width;
-    io.DisplaySize.y = height;
-    DrawImGui();
-    ImDrawData* drawData = ImGui::GetDrawData();
-    ImGui_ImplSDLGPU3_PrepareDrawData(drawData, commandBuffer);
+}
+
+static void Simulate()
+{
+    SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
+    if (!commandBuffer)
     {
-        SDL_GPUColorTargetInfo colorInfo{};
-        SDL_GPUDepthStencilTargetInfo depthInfo{};
-        colorInfo.texture = texture;
-        colorInfo.load_op = SDL_GPU_LOADOP_CLEAR;
-        colorInfo.store_op = SDL_GPU_STOREOP_STORE;
-        depthInfo.texture = depthTexture;
-        depthInfo.load_op = SDL_GPU_LOADOP_CLEAR;
-        depthInfo.stencil_load_op = SDL_GPU_LOADOP_CLEAR;
-        depthInfo.store_op = SDL_GPU_STOREOP_STORE;
-        depthInfo.clear_depth = 1.0f;
-        depthInfo.cycle = true;
-        SDL_GPURenderPass* renderPass = SDL_BeginGPURenderPass(commandBuffer, &colorInfo, 1, &depthInfo);
-        if (!renderPass)
+        SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
+        return;
+    }
+    /* rule changes can wake up regions that had settled under the old rules */
+    decltype(rules) previousRules = activeRules;
+    previousRules.frame = rules.frame;
+    if (std::memcmp(&previousRules, &rules, sizeof(rules)))
+    {
+        bricksDirty = FRAMES - 1;
+        transitionsDirty = true;
+        statsRun++;
+        RefreshFirstUniverse();
+    }
+    activeRules = rules;
+    if (transitionsDirty)
+    {
+        UploadTransitions(commandBuffer);
+    }
+    int simulated = kernel;
+    if (simulated == KERNEL_BOXSUM && rules.neighborhood != MOORE)
+    {
+        simulated = KERNEL_DEFAULT;
+    }
+    /* the other kernels only know the radius 1 neighborhoods */
+    if (rules.neighborhood == BOX || rules.neighborhood == DIAMOND)
+    {
+        simulated = KERNEL_LARGER_THAN_LIFE;
+    }
+    /* the other kernels only know bytes */
+    if (layout == LAYOUT_NIBBLES)
+    {
+        simulated = KERNEL_NIBBLE;
+    }
+    else if (layout == LAYOUT_BRICKS)
+    {
+        simulated = KERNEL_BRICKS;
+    }
+    if (IsBatching())
+    {
+        simulated = KERNEL_BATCH;
+    }
+    /* resets only seed, the kernels themselves never see the first frame */
+    if (rules.frame == 0)
+    {
+        simulated = KERNEL_SEED;
+        statsRun++;
+    }
+    int steps = 1;
+    switch (simulated)
+    {
+    case KERNEL_BITPLANE:
+        /* the planes are only kept up to date by the bitplane kernel itself */
+        if (planesDirty)
         {
-            SDL_Log("Failed to begin render pass: %s", SDL_GetError());
-            SDL_SubmitGPUCommandBuffer(commandBuffer);
-            return;
+            Pack(commandBuffer);
         }
-        SDL_BindGPUGraphicsPipeline(renderPass, graphicsPipeline);
-        SDL_GPUBufferBinding vertexBuffers[2]{};
-        vertexBuffers[0].buffer = vertexBuffer;
-        vertexBuffers[1].buffer = instanceBuffer;
-        /* TODO: read or write, which is better? */
-        SDL_BindGPUVertexBuffers(renderPass, 0, vertexBuffers, 2);
-        SDL_BindGPUVertexStorageTextures(renderPass, 0, &textures[writeFrame], 1);
-        SDL_PushGPUVertexUniformData(commandBuffer, 0, &viewProjMatrix, sizeof(viewProjMatrix));
-        SDL_PushGPUFragmentUniformData(commandBuffer, 0, &rules, sizeof(rules));
-        SDL_DrawGPUPrimitives(renderPass, 36, BOUNDS * BOUNDS * BOUNDS, 0, 0);
-        SDL_EndGPURenderPass(renderPass);
+        SimulateBitplane(commandBuffer);
+        break;
+    case KERNEL_BOXSUM:
+        SimulateBoxsum(commandBuffer);
+        break;
+    case KERNEL_TEMPORAL:
+        SimulateTemporal(commandBuffer);
+        steps = temporalSteps;
+        break;
+    case KERNEL_ACTIVE:
+        SimulateActive(commandBuffer);
+        break;
+    case KERNEL_SPLIT:
+        SimulateSplit(commandBuffer);
+        break;
+    case KERNEL_LARGER_THAN_LIFE:
+        SimulateLargerThanLife(commandBuffer);
+        break;
+    case KERNEL_BATCH:
+        SimulateBatch(commandBuffer);
+        break;
+    case KERNEL_SEED:
+        Seed(commandBuffer);
+        break;
+    case KERNEL_NIBBLE:
+        SimulateNibble(commandBuffer);
+        break;
+    case KERNEL_BRICKS:
+        SimulateBricks(commandBuffer);
+        break;
+    default:
+        SimulateTextures(commandBuffer, simulated);
+        break;
     }
+    planesDirty = simulated != KERNEL_BITPLANE;
+    /* skipped bricks keep whatever the write texture held, which is only
+     * correct while every generation since then went through the active path */
+    if (simulated == KERNEL_ACTIVE)
     {
-        SDL_GPUColorTargetInfo info{};
-        info.texture = texture;
-        info.load_op = SDL_GPU_LOADOP_LOAD;
-        info.store_op = SDL_GPU_STOREOP_STORE;
-        SDL_GPURenderPass* renderPass = SDL_BeginGPURenderPass(commandBuffer, &info, 1, nullptr);
-        if (!renderPass)
+        bricksDirty = std::max(0, bricksDirty - 1);
+    }
+    else
+    {
+        bricksDirty = FRAMES - 1;
+    }
+    /* the other layouts have no textures to reduce */
+    StatsReadback* readback = nullptr;
+    if ((statistics || policy != POLICY_OFF) && layout == LAYOUT_BYTES && !IsBatching())
+    {
+        readback = Measure(commandBuffer);
+    }
+    if (readback)
+    {
+        readback->frame = rules.frame + steps;
+        readback->clock = ++statsClock;
+        readback->run = statsRun;
+        readback->fence = SDL_SubmitGPUCommandBufferAndAcquireFence(commandBuffer);
+        if (!readback->fence)
         {
-            SDL_Log("Failed to begin render pass: %s", SDL_GetError());
-            SDL_SubmitGPUCommandBuffer(commandBuffer);
-            return;
+            SDL_Log("Failed to submit command buffer: %s", SDL_GetError());
         }
-        ImGui_ImplSDLGPU3_RenderDrawData(drawData, commandBuffer, renderPass);
-        SDL_EndGPURenderPass(renderPass);
     }
-    SDL_SubmitGPUCommandBuffer(commandBuffer);
+    else
+    {
+        SDL_SubmitGPUCommandBuffer(commandBuffer);
+    }
+    readFrame = (readFrame + 1) % FRAMES;
+    writeFrame = (writeFrame + 1) % FRAMES;
+    rules.frame += steps;
 }
 
-static void Simulate()
+/* copies a byte texture of the grid back, waiting for it */
+static bool DownloadCells(SDL_GPUTexture* texture, std::vector<uint8_t>& cells)
 {
+    uint32_t size = rules.width * rules.height * rules.depth;
+    SDL_GPUTransferBufferCreateInfo info{};
+    info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+    info.size = size;
+    SDL_GPUTransferBuffer* transferBuffer = SDL_CreateGPUTransferBuffer(device, &info);
+    if (!transferBuffer)
+    {
+        SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
+        return false;
+    }
     SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
     if (!commandBuffer)
     {
         SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
-        return;
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return false;
     }
-    SDL_GPUStorageTextureReadWriteBinding textureBinding{};
-    textureBinding.texture = textures[writeFrame];
-    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, &textureBinding, 1, nullptr, 0);
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    if (!copyPass)
+    {
+        SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+        SDL_CancelGPUCommandBuffer(commandBuffer);
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return false;
+    }
+    SDL_GPUTextureRegion region{};
+    SDL_GPUTextureTransferInfo transferInfo{};
+    region.texture = texture;
+    region.w = rules.width;
+    region.h = rules.height;
+    region.d = rules.depth;
+    transferInfo.transfer_buffer = transferBuffer;
+    SDL_DownloadFromGPUTexture(copyPass, &region, &transferInfo);
+    SDL_EndGPUCopyPass(copyPass);
+    SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(commandBuffer);
+    if (!fence)
+    {
+        SDL_Log("Failed to submit command buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return false;
+    }
+    SDL_WaitForGPUFences(device, true, &fence, 1);
+    SDL_ReleaseGPUFence(device, fence);
+    const uint8_t* data = static_cast<const uint8_t*>(SDL_MapGPUTransferBuffer(device, transferBuffer, false));
+    if (!data)
+    {
+        SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return false;
+    }
+    cells.assign(data, data + size);
+    SDL_UnmapGPUTransferBuffer(device, transferBuffer);
+    SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+    return true;
+}
+
+/* sdl doesn't report subgroup features, so a probe dispatch reads back the subgroup size and whether
+ * shuffles return the adjacent lanes */
+static bool ProbeSubgroups()
+{
+    SDL_GPUComputePipeline* pipeline = GetComputePipeline(device, "subgroupprobe.comp");
+    if (!pipeline)
+    {
+        SDL_Log("Subgroup shuffles aren't supported");
+        return false;
+    }
+    uint32_t result[2];
+    SDL_GPUBufferCreateInfo bufferInfo{};
+    bufferInfo.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+    bufferInfo.size = sizeof(result);
+    SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer(device, &bufferInfo);
+    if (!buffer)
+    {
+        SDL_Log("Failed to create buffer: %s", SDL_GetError());
+        return false;
+    }
+    SDL_GPUTransferBufferCreateInfo transferInfo{};
+    transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+    transferInfo.size = sizeof(result);
+    SDL_GPUTransferBuffer* transferBuffer = SDL_CreateGPUTransferBuffer(device, &transferInfo);
+    if (!transferBuffer)
+    {
+        SDL_Log("Failed to create transfer buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUBuffer(device, buffer);
+        return false;
+    }
+    SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(device);
+    if (!commandBuffer)
+    {
+        SDL_Log("Failed to acquire command buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        SDL_ReleaseGPUBuffer(device, buffer);
+        return false;
+    }
+    SDL_GPUStorageBufferReadWriteBinding bufferBinding{};
+    bufferBinding.buffer = buffer;
+    SDL_GPUComputePass* computePass = SDL_BeginGPUComputePass(commandBuffer, nullptr, 0, &bufferBinding, 1);
     if (!computePass)
     {
         SDL_Log("Failed to begin compute pass: %s", SDL_GetError());
-        SDL_SubmitGPUCommandBuffer(commandBuffer);
-        return;
+        SDL_CancelGPUCommandBuffer(commandBuffer);
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        SDL_ReleaseGPUBuffer(device, buffer);
+        return false;
     }
-    SDL_BindGPUComputePipeline(computePass, computePipeline);
-    SDL_PushGPUComputeUniformData(commandBuffer, 0, &rules, sizeof(rules));
-    SDL_BindGPUComputeStorageTextures(computePass, 0, &textures[readFrame], 1);
-    int groups = (BOUNDS + THREADS - 1) / THREADS;
-    SDL_DispatchGPUCompute(computePass, groups, groups, groups);
+    SDL_BindGPUComputePipeline(computePass, pipeline);
+    SDL_DispatchGPUCompute(computePass, 1, 1, 1);
     SDL_EndGPUComputePass(computePass);
-    SDL_SubmitGPUCommandBuffer(commandBuffer);
-    readFrame = (readFrame + 1) % FRAMES;
-    writeFrame = (writeFrame + 1) % FRAMES;
-    rules.frame++;
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    if (!copyPass)
+    {
+        SDL_Log("Failed to begin copy pass: %s", SDL_GetError());
+        SDL_CancelGPUCommandBuffer(commandBuffer);
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        SDL_ReleaseGPUBuffer(device, buffer);
+        return false;
+    }
+    SDL_GPUBufferRegion region{};
+    SDL_GPUTransferBufferLocation location{};
+    region.buffer = buffer;
+    region.size = sizeof(result);
+    location.transfer_buffer = transferBuffer;
+    SDL_DownloadFromGPUBuffer(copyPass, &region, &location);
+    SDL_EndGPUCopyPass(copyPass);
+    SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(commandBuffer);
+    SDL_ReleaseGPUBuffer(device, buffer);
+    if (!fence)
+    {
+        SDL_Log("Failed to submit command buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return false;
+    }
+    SDL_WaitForGPUFences(device, true, &fence, 1);
+    SDL_ReleaseGPUFence(device, fence);
+    const uint32_t* data = static_cast<const uint32_t*>(SDL_MapGPUTransferBuffer(device, transferBuffer, false));
+    if (!data)
+    {
+        SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return false;
+    }
+    std::memcpy(result, data, sizeof(result));
+    SDL_UnmapGPUTransferBuffer(device, transferBuffer);
+    SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+    /* a subgroup of one has no neighbors to shuffle */
+    bool supported = result[0] > 1 && result[1] == 0;
+    SDL_Log("Subgroup size %u, shuffles %s", result[0], supported ? "work" : "don't work");
+    return supported;
+}
+
+/* counts the cells an engine disagrees with the gpu on, logging the first */
+static size_t Compare(const char* name, const std::vector<uint8_t>& cells, const std::vector<uint8_t>& gpuCells)
+{
+    size_t differences = 0;
+    size_t first = 0;
+    for (size_t i = 0; i < cells.size(); i++)
+    {
+        if (cells[i] != gpuCells[i])
+        {
+            first = differences ? first : i;
+            differences++;
+        }
+    }
+    if (differences)
+    {
+        uint32_t x = first % rules.width;
+        uint32_t y = first / rules.width % rules.height;
+        uint32_t z = first / (rules.width * rules.height);
+        SDL_Log("%s differs first at (%u, %u, %u): GPU %u, CPU %u", name, x, y, z, gpuCells[first], cells[first]);
+    }
+    return differences;
+}
+
+/* simulates once with the current kernel and compares the result with the cpu engines */
+static void Verify()
+{
+    if (customTransitions)
+    {
+        verification = "The CPU engines only know the preset transitions";
+        SDL_Log("%s", verification.data());
+        return;
+    }
+    std::vector<uint8_t> before;
+    std::vector<uint8_t> after;
+    Rules verified = rules;
+    if (!DownloadCells(textures[readFrame], before))
+    {
+        return;
+    }
+    Simulate();
+    if (!DownloadCells(textures[readFrame], after))
+    {
+        return;
+    }
+    engine.SetRules(verified);
+    engine.SetCells(before);
+    while (engine.GetRules().frame < rules.frame)
+    {
+        engine.Step();
+    }
+    size_t differences = Compare("Reference", engine.GetCells(), after);
+    verification = std::format("Frame {}: {} of {} cells differ", verified.frame, differences, after.size());
+    /* the bit-sliced engine only knows the radius 1 neighborhoods */
+    if (bitEngine.SetRules(verified))
+    {
+        bitEngine.SetCells(before);
+        while (bitEngine.GetRules().frame < rules.frame)
+        {
+            bitEngine.Step();
+        }
+        differences = Compare("Bit-sliced", bitEngine.GetCells(), after);
+        verification += std::format(", {} bit-sliced", differences);
+    }
+    /* hashlife only knows binary rules and has no boundary, so cells that escape the grid can come back
+     * differently, which is reported alongside the differences */
+    if (hashEngine.SetRules(verified))
+    {
+        hashEngine.SetCells(before);
+        hashEngine.Advance(rules.frame - verified.frame);
+        const std::vector<uint8_t>& hashCells = hashEngine.GetCells();
+        bool escaped = hashEngine.GetPopulation() != uint64_t(std::count(hashCells.begin(), hashCells.end(), 1));
+        differences = Compare("HashLife", hashCells, after);
+        verification += std::format(", {} hashlife{}", differences, escaped ? " (escaped)" : "");
+    }
+    SDL_Log("%s", verification.data());
 }
 
 int main(int argc, char** argv)
 {
+    /* automata [width height depth] */
+    if (argc == 4)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            gridSize[i] = std::max(1, std::atoi(argv[i + 1]));
+        }
+        rules.width = gridSize[0];
+        rules.height = gridSize[1];
+        rules.depth = gridSize[2];
+    }
     if (!Init())
     {
         SDL_Log("Failed to initialize");
@@ -560,8 +3093,14 @@ int main(int argc, char** argv)
         SDL_Log("Failed to create resources");
         return 1;
     }
+    LoadTunings();
+    subgroups = ProbeSubgroups();
+    Scheduler scheduler;
+    engine.SetScheduler(&scheduler);
+    bitEngine.SetScheduler(&scheduler);
+    hashEngine.SetScheduler(&scheduler);
     std::srand(std::time(nullptr));
-    rules.seed = std::rand() % RAND_MAX;
+    rules.seed = NextSeed();
     bool running = true;
     while (running)
     {
@@ -596,7 +3135,7 @@ int main(int argc, char** argv)
             case SDL_EVENT_KEY_DOWN:
                 if (event.key.scancode == SDL_SCANCODE_R)
                 {
-                    rules.seed = std::rand() % RAND_MAX;
+                    rules.seed = NextSeed();
                     rules.frame = 0;
                 }
                 break;
@@ -606,26 +3145,129 @@ int main(int argc, char** argv)
         {
             break;
         }
+        PollStats();
         Draw();
-        if (delta < delay)
+        if (resizing)
+        {
+            resizing = false;
+            for (int i = 0; i < 3; i++)
+            {
+                gridSize[i] = std::max(1, gridSize[i]);
+            }
+            if (!Resize(gridSize[0], gridSize[1], gridSize[2]))
+            {
+                SDL_Log("Failed to recreate grid");
+                break;
+            }
+            gridSize[0] = rules.width;
+            gridSize[1] = rules.height;
+            gridSize[2] = rules.depth;
+        }
+        if (batching)
+        {
+            batching = false;
+            batchSettings[0] = std::clamp(batchSettings[0], 0, MAX_UNIVERSES);
+            batchSettings[1] = std::max(1, batchSettings[1]);
+            if (!CreateBatch(batchSettings[0], batchSettings[1]))
+            {
+                SDL_Log("Failed to create batch");
+                batchSettings[0] = 0;
+            }
+        }
+        if (GetLayout() != layout)
+        {
+            int newLayout = GetLayout();
+            if (!Relayout(newLayout))
+            {
+                SDL_Log("Failed to recreate the grid");
+                break;
+            }
+            /* puts back the settings that asked for the layout so it isn't retried every frame */
+            if (layout != newLayout)
+            {
+                SDL_Log("Failed to change layout, keeping the previous one");
+                bricking = layout == LAYOUT_BRICKS;
+                packing = layout == LAYOUT_NIBBLES || (packing && newLayout != LAYOUT_NIBBLES);
+                if (GetLayout() != layout)
+                {
+                    rules.neighborhood = activeRules.neighborhood;
+                    rules.life = activeRules.life;
+                }
+            }
+        }
+        if (autotune && IsTunable() && !tunings.contains(GetTuningKey()))
+        {
+            Autotune();
+        }
+        /* the cpu reference only reads bytes */
+        if (verifying)
+        {
+            verifying = false;
+            if (layout == LAYOUT_BYTES && !IsBatching())
+            {
+                Verify();
+            }
+            else
+            {
+                SDL_Log("Verifying needs bytes and no batch");
+            }
+        }
+        PrefetchSeeds();
+        if (delta < delay || paused)
         {
             continue;
         }
         delta = 0.0f;
         Simulate();
     }
-    for (int i = 0; i < FRAMES; i++)
+    SDL_WaitForGPUIdle(device);
+    PollSeedSpills();
+    PollStats();
+    for (StatsReadback& readback : statsReadbacks)
     {
-        SDL_ReleaseGPUTexture(device, textures[i]);
+        SDL_ReleaseGPUTransferBuffer(device, readback.transferBuffer);
     }
+    SDL_ReleaseGPUBuffer(device, statsBuffer);
+    SDL_ReleaseGPUTransferBuffer(device, statsResetTransferBuffer);
+    ReleaseGrid();
+    ReleaseBatch();
     SDL_ReleaseGPUTexture(device, depthTexture);
     SDL_ReleaseGPUBuffer(device, vertexBuffer);
-    SDL_ReleaseGPUBuffer(device, instanceBuffer);
+    SDL_ReleaseGPUBuffer(device, argsBuffer);
+    SDL_ReleaseGPUTransferBuffer(device, argsTransferBuffer);
+    SDL_ReleaseGPUBuffer(device, transitionsBuffer);
+    SDL_ReleaseGPUTransferBuffer(device, transitionsTransferBuffer);
     ImGui_ImplSDLGPU3_Shutdown();
     ImGui_ImplSDL3_Shutdown();
     ImGui::DestroyContext();
     SDL_ReleaseGPUGraphicsPipeline(device, graphicsPipeline);
+    SDL_ReleaseGPUGraphicsPipeline(device, nibbleGraphicsPipeline);
+    SDL_ReleaseGPUGraphicsPipeline(device, bricksGraphicsPipeline);
     SDL_ReleaseGPUComputePipeline(device, computePipeline);
+    SDL_ReleaseGPUComputePipeline(device, tiledPipeline);
+    SDL_ReleaseGPUComputePipeline(device, packPipeline);
+    SDL_ReleaseGPUComputePipeline(device, bitplanePipeline);
+    SDL_ReleaseGPUComputePipeline(device, boxsumPipeline);
+    SDL_ReleaseGPUComputePipeline(device, boxrulePipeline);
+    SDL_ReleaseGPUComputePipeline(device, temporalPipeline);
+    SDL_ReleaseGPUComputePipeline(device, activePipeline);
+    SDL_ReleaseGPUComputePipeline(device, compactPipeline);
+    SDL_ReleaseGPUComputePipeline(device, interiorPipeline);
+    SDL_ReleaseGPUComputePipeline(device, borderPipeline);
+    SDL_ReleaseGPUComputePipeline(device, prefixPipeline);
+    SDL_ReleaseGPUComputePipeline(device, scanPipeline);
+    SDL_ReleaseGPUComputePipeline(device, ltlPipeline);
+    SDL_ReleaseGPUComputePipeline(device, batchPipeline);
+    SDL_ReleaseGPUComputePipeline(device, seedPipeline);
+    SDL_ReleaseGPUComputePipeline(device, seedBatchPipeline);
+    SDL_ReleaseGPUComputePipeline(device, nibblePipeline);
+    SDL_ReleaseGPUComputePipeline(device, nibblePackPipeline);
+    SDL_ReleaseGPUComputePipeline(device, nibbleUnpackPipeline);
+    SDL_ReleaseGPUComputePipeline(device, brickPipeline);
+    SDL_ReleaseGPUComputePipeline(device, brickPackPipeline);
+    SDL_ReleaseGPUComputePipeline(device, brickUnpackPipeline);
+    SDL_ReleaseGPUComputePipeline(device, statsPipeline);
+    ReleaseComputePipelines(device);
     SDL_ReleaseWindowFromGPUDevice(device, window);
     SDL_DestroyGPUDevice(device);
     SDL_DestroyWindow(window);
@@ -12,6 +12,17 @@ layout(set = 3, binding = 0) uniform uniformRules
     uint life;
     uint neighborhood;
     uint frame;
+    uint width;
+    uint height;
+    uint depth;
+    uint boundary;
+    uint radius;
+    uint birthMin;
+    uint birthMax;
+    uint surviveMin;
+    uint surviveMax;
+    float frequency;
+    float threshold;
 };
 
 void main()
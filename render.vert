@@ -1,21 +1,47 @@
 #version 450
 
+#include "bricks.glsl"
+
 layout(location = 0) in vec3 inPosition;
-layout(location = 1) in uint inInstance;
 layout(location = 0) out flat uint outValue;
+#if defined(NIBBLE)
+layout(set = 0, binding = 0, r32ui) uniform readonly uimage3D cells;
+#elif defined(BRICKS)
+layout(set = 0, binding = 0) readonly buffer bufferCells
+{
+    uint cells[];
+};
+#else
 layout(set = 0, binding = 0, r8ui) uniform readonly uimage3D cells;
-layout(set = 1, binding = 0) uniform uniformViewProjMatrix
+#endif
+layout(set = 1, binding = 0) uniform uniformView
 {
     mat4 viewProjMatrix;
+    uint width;
+    uint height;
+    uint depth;
+    uint offsetX;
+    uint offsetY;
+    uint offsetZ;
 };
 
 void main()
 {
+    /* one instance per cell */
     ivec3 instance;
-    instance.x = int((inInstance >>  0) & 0x3FF);
-    instance.y = int((inInstance >> 10) & 0x3FF);
-    instance.z = int((inInstance >> 20) & 0x3FF);
-    outValue = imageLoad(cells, instance).x;
+    instance.x = int(uint(gl_InstanceIndex) % width);
+    instance.y = int(uint(gl_InstanceIndex) / width % height);
+    instance.z = int(uint(gl_InstanceIndex) / (width * height));
+    ivec3 cell = instance + ivec3(offsetX, offsetY, offsetZ);
+#if defined(NIBBLE)
+    /* 8 cells per word along x */
+    outValue = (imageLoad(cells, ivec3(cell.x / 8, cell.yz)).x >> (4 * (cell.x % 8))) & 0xFu;
+#elif defined(BRICKS)
+    uint index = GetCellIndex(cell, ivec3(width, height, depth));
+    outValue = (cells[index / 4] >> (8 * (index % 4))) & 0xFFu;
+#else
+    outValue = imageLoad(cells, cell).x;
+#endif
     if (outValue > 0)
     {
         gl_Position = viewProjMatrix * vec4(inPosition + vec3(instance), 1.0f);
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+#include "config.hpp"
+
+/* mirrors uniformRules in automata.glsl */
+struct Rules
+{
+    uint32_t seed{0};
+    uint32_t surviveMask{16};
+    uint32_t birthMask{96};
+    uint32_t life{32};
+    uint32_t neighborhood{MOORE};
+    uint32_t frame{0};
+    uint32_t width{BOUNDS};
+    uint32_t height{BOUNDS};
+    uint32_t depth{BOUNDS};
+    uint32_t boundary{BOUNDARY_DEAD};
+    uint32_t radius{2};
+    uint32_t birthMin{20};
+    uint32_t birthMax{30};
+    uint32_t surviveMin{15};
+    uint32_t surviveMax{35};
+    float frequency{0.1f};
+    float threshold{0.65f};
+};
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "config.hpp"
+#include "scheduler.hpp"
+
+/* how long an idle thread polls for the next generation before it sleeps */
+static constexpr int SPINS = 4096;
+
+static void Pin(std::thread::native_handle_type thread, int core)
+{
+#if defined(_WIN32)
+    if (core < 64)
+    {
+        SetThreadAffinityMask(thread, DWORD_PTR(1) << core);
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    pthread_setaffinity_np(thread, sizeof(set), &set);
+#else
+    /* macos only has affinity hints, so pinning is a no-op there */
+    (void) thread;
+    (void) core;
+#endif
+}
+
+Scheduler::Scheduler(int count, bool pin)
+{
+    if (count <= 0)
+    {
+        count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (int i = 0; i < count; i++)
+    {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (int i = 1; i < count; i++)
+    {
+        threads.emplace_back(&Scheduler::Loop, this, i);
+        if (pin)
+        {
+            Pin(threads.back().native_handle(), i);
+        }
+    }
+#if defined(_WIN32)
+    if (pin)
+    {
+        SetThreadAffinityMask(GetCurrentThread(), 1);
+    }
+#elif defined(__linux__)
+    if (pin)
+    {
+        Pin(pthread_self(), 0);
+    }
+#endif
+}
+
+Scheduler::~Scheduler()
+{
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+        generation++;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+int Scheduler::GetThreads() const
+{
+    return int(workers.size());
+}
+
+void Scheduler::Run(int count, const std::function<void(int)>& newTask)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    task = &newTask;
+    remaining = count;
+    /* contiguous runs per thread so neighboring slabs stay on one core until something is stolen */
+    int threadCount = GetThreads();
+    for (int i = 0; i < threadCount; i++)
+    {
+        Worker& worker = *workers[i];
+        std::lock_guard lock(worker.mutex);
+        for (int j = count * i / threadCount; j < count * (i + 1) / threadCount; j++)
+        {
+            worker.tasks.push_front(j);
+        }
+    }
+    {
+        std::lock_guard lock(mutex);
+        generation++;
+    }
+    wake.notify_all();
+    Work(0);
+    /* the generation barrier, the last tasks are already running on other threads */
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+bool Scheduler::Pop(int index, int& popped)
+{
+    {
+        Worker& worker = *workers[index];
+        std::lock_guard lock(worker.mutex);
+        if (!worker.tasks.empty())
+        {
+            popped = worker.tasks.back();
+            worker.tasks.pop_back();
+            return true;
+        }
+    }
+    int count = GetThreads();
+    for (int i = 1; i < count; i++)
+    {
+        Worker& victim = *workers[(index + i) % count];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            popped = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void Scheduler::Work(int worker)
+{
+    int popped;
+    while (Pop(worker, popped))
+    {
+        (*task)(popped);
+        remaining.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void Scheduler::Loop(int worker)
+{
+    uint64_t seen = 0;
+    while (true)
+    {
+        for (int i = 0; i < SPINS && generation.load(std::memory_order_acquire) == seen; i++)
+        {
+            std::this_thread::yield();
+        }
+        {
+            std::unique_lock lock(mutex);
+            wake.wait(lock, [&] { return generation != seen; });
+            seen = generation;
+            if (stopping)
+            {
+                return;
+            }
+        }
+        Work(worker);
+    }
+}
+
+void ForEachSlab(Scheduler* scheduler, int depth, size_t planeBytes, const std::function<void(int, int)>& slab)
+{
+    if (!scheduler || scheduler->GetThreads() == 1)
+    {
+        slab(0, depth);
+        return;
+    }
+    int planes = int(std::max<size_t>(1, SLAB_BYTES / std::max<size_t>(1, planeBytes)));
+    planes = std::clamp(depth / (scheduler->GetThreads() * SLAB_TASKS), 1, planes);
+    int count = (depth + planes - 1) / planes;
+    scheduler->Run(count, [&](int i)
+    {
+        slab(i * planes, std::min(depth, (i + 1) * planes));
+    });
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* work-stealing pool for the cpu engines, each thread pops its own tasks from the back of its deque
+ * and steals from the front of the others once it runs out */
+class Scheduler
+{
+public:
+    /* 0 threads uses every hardware thread, the calling thread being one of them, and pinning
+     * puts thread i (the calling thread is 0) on core i */
+    explicit Scheduler(int threads = 0, bool pin = false);
+    ~Scheduler();
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    int GetThreads() const;
+
+    /* runs task(0) to task(count - 1) and returns once every one of them finished */
+    void Run(int count, const std::function<void(int)>& task);
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    void Loop(int worker);
+    bool Pop(int worker, int& task);
+    void Work(int worker);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    const std::function<void(int)>* task{nullptr};
+    std::atomic<int> remaining{0};
+    std::atomic<uint64_t> generation{0};
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping{false};
+};
+
+/* splits the planes along z into slabs of about SLAB_BYTES (but at least SLAB_TASKS per thread)
+ * and calls slab(begin, end) for each, on the scheduler when there is one */
+void ForEachSlab(Scheduler* scheduler, int depth, size_t planeBytes, const std::function<void(int, int)>& slab);
\ No newline at end of file
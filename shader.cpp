@@ -1,6 +1,7 @@
 #include <SDL3/SDL.h>
 
 #include <cassert>
+#include <charconv>
 #include <cstdint>
 #include <cstring>
 #include <format>
@@ -8,10 +9,13 @@
 #include <iterator>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 
 #include "jsmn.h"
 #include "shader.hpp"
 
+static std::unordered_map<std::string, SDL_GPUComputePipeline*> computePipelines;
+
 static void* Load(SDL_GPUDevice* device, const std::string_view& name)
 {
     SDL_GPUShaderFormat shaderFormat = SDL_GetGPUShaderFormats(device);
@@ -76,6 +80,7 @@ static void* Load(SDL_GPUDevice* device, const std::string_view& name)
             }
             char* keyString = jsonData.data() + tokens[i + 0].start;
             char* valueString = jsonData.data() + tokens[i + 1].start;
+            char* valueEnd = jsonData.data() + tokens[i + 1].end;
             int keySize = tokens[i + 0].end - tokens[i + 0].start;
             uint32_t* value;
             if (!std::memcmp("samplers", keyString, keySize))
@@ -118,7 +123,12 @@ static void* Load(SDL_GPUDevice* device, const std::string_view& name)
             {
                 assert(false);
             }
-            *value = *valueString - '0';
+            /* thread counts of the autotuned shapes have more than one digit */
+            if (std::from_chars(valueString, valueEnd, *value).ec != std::errc())
+            {
+                SDL_Log("Bad json value: %s", jsonPath.data());
+                return nullptr;
+            }
         }
         info.code = reinterpret_cast<Uint8*>(shaderData.data());
         info.code_size = shaderData.size();
@@ -138,6 +148,7 @@ static void* Load(SDL_GPUDevice* device, const std::string_view& name)
             }
             char* keyString = jsonData.data() + tokens[i + 0].start;
             char* valueString = jsonData.data() + tokens[i + 1].start;
+            char* valueEnd = jsonData.data() + tokens[i + 1].end;
             int keySize = tokens[i + 0].end - tokens[i + 0].start;
             uint32_t* value;
             if (!std::memcmp("samplers", keyString, keySize))
@@ -160,7 +171,11 @@ static void* Load(SDL_GPUDevice* device, const std::string_view& name)
             {
                 assert(false);
             }
-            *value = *valueString - '0';
+            if (std::from_chars(valueString, valueEnd, *value).ec != std::errc())
+            {
+                SDL_Log("Bad json value: %s", jsonPath.data());
+                return nullptr;
+            }
         }
         info.code = reinterpret_cast<Uint8*>(shaderData.data());
         info.code_size = shaderData.size();
@@ -192,4 +207,30 @@ SDL_GPUShader* LoadShader(SDL_GPUDevice* device, const std::string_view& name)
 SDL_GPUComputePipeline* LoadComputePipeline(SDL_GPUDevice* device, const std::string_view& name)
 {
     return static_cast<SDL_GPUComputePipeline*>(Load(device, name));
+}
+
+SDL_GPUComputePipeline* GetComputePipeline(SDL_GPUDevice* device, const std::string_view& name)
+{
+    std::string key(name);
+    auto it = computePipelines.find(key);
+    if (it != computePipelines.end())
+    {
+        return it->second;
+    }
+    /* failures are cached too so a missing variant is only reported once */
+    SDL_GPUComputePipeline* pipeline = LoadComputePipeline(device, name);
+    computePipelines.emplace(key, pipeline);
+    return pipeline;
+}
+
+void ReleaseComputePipelines(SDL_GPUDevice* device)
+{
+    for (auto& [name, pipeline] : computePipelines)
+    {
+        if (pipeline)
+        {
+            SDL_ReleaseGPUComputePipeline(device, pipeline);
+        }
+    }
+    computePipelines.clear();
 }
\ No newline at end of file
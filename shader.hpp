@@ -5,4 +5,8 @@
 #include <string_view>
 
 SDL_GPUShader* LoadShader(SDL_GPUDevice* device, const std::string_view& name);
-SDL_GPUComputePipeline* LoadComputePipeline(SDL_GPUDevice* device, const std::string_view& name);
\ No newline at end of file
+SDL_GPUComputePipeline* LoadComputePipeline(SDL_GPUDevice* device, const std::string_view& name);
+
+/* loads a compute pipeline the first time it's asked for and keeps it until released */
+SDL_GPUComputePipeline* GetComputePipeline(SDL_GPUDevice* device, const std::string_view& name);
+void ReleaseComputePipelines(SDL_GPUDevice* device);
\ No newline at end of file